@@ -0,0 +1,210 @@
+// GameObject allocation benchmark and stress check. Built with -DENGINE_BUILD_BENCHMARKS=ON.
+//
+//   allocator_bench [rounds]
+//
+// First times create/destroy on one thread with new/delete, the pool behind its lock, and
+// GameObjectAllocator's magazines. Then several threads create objects and hand half of
+// them to a neighbour to destroy, so magazines fill on one thread and empty on another and
+// keep moving through the depot. Every live object is tracked; the check fails if a slot is
+// handed out twice, freed twice, or leaked. Exits non-zero on failure.
+#include <engine/GameObjectAllocator.hpp>
+#include <engine/GameObject.h>
+#include <engine/MemoryStats.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <random>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int BATCH = 200;
+    constexpr size_t POOL_CHUNK = 256;
+
+    // Create BATCH objects, destroy them all, repeat. Returns ns per create+destroy.
+    template <typename Create, typename Destroy>
+    double timeSingleThread(int rounds, Create create, Destroy destroy) {
+        std::vector<GameObject*> live;
+        live.reserve(BATCH);
+
+        auto start = Clock::now();
+        for (int r = 0; r < rounds; r++) {
+            for (int i = 0; i < BATCH; i++) live.push_back(create());
+            for (GameObject* obj : live) destroy(obj);
+            live.clear();
+        }
+        std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+        return elapsed.count() / (double(rounds) * BATCH);
+    }
+
+    // Every object the stress threads hold, split into stripes so bookkeeping doesn't
+    // serialize the threads it is checking
+    class LiveSet {
+    public:
+        bool insert(GameObject* obj) {
+            Stripe& stripe = stripeFor(obj);
+            std::lock_guard<std::mutex> lock(stripe.mutex);
+            return stripe.objects.insert(obj).second;
+        }
+
+        bool erase(GameObject* obj) {
+            Stripe& stripe = stripeFor(obj);
+            std::lock_guard<std::mutex> lock(stripe.mutex);
+            return stripe.objects.erase(obj) == 1;
+        }
+
+        size_t size() {
+            size_t total = 0;
+            for (Stripe& stripe : stripes) {
+                std::lock_guard<std::mutex> lock(stripe.mutex);
+                total += stripe.objects.size();
+            }
+            return total;
+        }
+
+    private:
+        struct Stripe {
+            std::mutex mutex;
+            std::unordered_set<GameObject*> objects;
+        };
+
+        Stripe& stripeFor(GameObject* obj) {
+            return stripes[(reinterpret_cast<uintptr_t>(obj) / sizeof(GameObject)) % STRIPES];
+        }
+
+        static constexpr size_t STRIPES = 64;
+        Stripe stripes[STRIPES];
+    };
+
+    // Objects another thread created for this one to destroy
+    struct Inbox {
+        std::mutex mutex;
+        std::vector<GameObject*> objects;
+    };
+
+    bool stressCrossThread(int threadCount, int rounds) {
+        LiveSet live;
+        std::vector<Inbox> inboxes(threadCount);
+        std::atomic<int> errors{ 0 };
+
+        auto destroy = [&](GameObject* obj) {
+            if (!live.erase(obj)) errors.fetch_add(1);
+            GameObjectAllocator::destroy(obj);
+        };
+
+        auto worker = [&](int self) {
+            std::mt19937 rng(self + 1);
+            std::uniform_int_distribution<int> batchSize(1, BATCH);
+            std::vector<GameObject*> mine, received;
+            Inbox& neighbour = inboxes[(self + 1) % threadCount];
+
+            for (int r = 0; r < rounds; r++) {
+                int count = batchSize(rng);
+                for (int i = 0; i < count; i++) {
+                    GameObject* obj = GameObjectAllocator::create();
+                    if (!obj) { errors.fetch_add(1); continue; }
+                    if (!live.insert(obj)) errors.fetch_add(1);
+                    mine.push_back(obj);
+                }
+
+                // Half go to the neighbour, the rest are freed here in a shuffled order
+                std::shuffle(mine.begin(), mine.end(), rng);
+                size_t half = mine.size() / 2;
+                {
+                    std::lock_guard<std::mutex> lock(neighbour.mutex);
+                    neighbour.objects.insert(neighbour.objects.end(), mine.begin(), mine.begin() + half);
+                }
+                for (size_t i = half; i < mine.size(); i++) destroy(mine[i]);
+                mine.clear();
+
+                {
+                    std::lock_guard<std::mutex> lock(inboxes[self].mutex);
+                    received.swap(inboxes[self].objects);
+                }
+                for (GameObject* obj : received) destroy(obj);
+                received.clear();
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadCount; t++) threads.emplace_back(worker, t);
+        for (std::thread& thread : threads) thread.join();
+
+        // Whatever was handed over after its receiver finished
+        for (Inbox& inbox : inboxes) {
+            for (GameObject* obj : inbox.objects) destroy(obj);
+            inbox.objects.clear();
+        }
+
+        bool ok = true;
+        if (errors.load() != 0) {
+            std::printf("  FAIL: %d duplicate handouts, double frees or failed creates\n", errors.load());
+            ok = false;
+        }
+        if (live.size() != 0 || GameObjectAllocator::getPoolUsedCount() != 0) {
+            std::printf("  FAIL: %zu objects tracked, %zu counted live after every destroy\n",
+                live.size(), GameObjectAllocator::getPoolUsedCount());
+            ok = false;
+        }
+        return ok;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int rounds = argc > 1 ? std::atoi(argv[1]) : 2000;
+    if (rounds <= 0) rounds = 2000;
+
+    GameObjectAllocator::setPoolCapacity(POOL_CHUNK);
+
+    // Single thread
+    GameObjectPool lockedPool(POOL_CHUNK);
+
+    GameObjectAllocator::setMode(GameObjectAllocator::DYNAMIC);
+    double heapNs = timeSingleThread(rounds,
+        [] { return GameObjectAllocator::create(); },
+        [](GameObject* obj) { GameObjectAllocator::destroy(obj); });
+
+    double lockedNs = timeSingleThread(rounds,
+        [&] { return new (lockedPool.allocate()) GameObject(); },
+        [&](GameObject* obj) { obj->~GameObject(); lockedPool.deallocate(obj); });
+
+    GameObjectAllocator::setMode(GameObjectAllocator::POOLED);
+    double magazineNs = timeSingleThread(rounds,
+        [] { return GameObjectAllocator::create(); },
+        [](GameObject* obj) { GameObjectAllocator::destroy(obj); });
+
+    // What Config::sampleAllocLatency adds to every create
+    MemoryStats::setLatencySampling(true);
+    double sampledNs = timeSingleThread(rounds,
+        [] { return GameObjectAllocator::create(); },
+        [](GameObject* obj) { GameObjectAllocator::destroy(obj); });
+    MemoryStats::setLatencySampling(false);
+
+    std::printf("single thread, %d objects x %d rounds (ns per create+destroy)\n", BATCH, rounds);
+    std::printf("  new/delete            %8.1f\n", heapNs);
+    std::printf("  locked pool           %8.1f\n", lockedNs);
+    std::printf("  magazines             %8.1f\n", magazineNs);
+    std::printf("  magazines, sampled    %8.1f\n", sampledNs);
+
+    // Cross-thread create/destroy
+    bool ok = true;
+    for (int threads : { 2, 4, 8 }) {
+        auto start = Clock::now();
+        bool passed = stressCrossThread(threads, rounds);
+        std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+        std::printf("stress, %d threads: %s (%.0f ms)\n", threads, passed ? "ok" : "FAILED", elapsed.count());
+        ok = ok && passed;
+    }
+
+    std::printf("pool: %zu chunks, high water mark %zu objects\n",
+        GameObjectAllocator::getPoolChunkCount(), GameObjectAllocator::getPoolHighWaterMark());
+    return ok ? 0 : 1;
+}
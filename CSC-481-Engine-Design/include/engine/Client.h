@@ -37,5 +37,8 @@ private:
 
 	bool awaitingReply = false;
 
+	// Reused by sendCommand for every message
+	std::string sendBuffer;
+
     int latestTick = 0;
 };
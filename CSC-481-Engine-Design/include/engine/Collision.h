@@ -17,8 +17,13 @@ public:
         if (!ta || !tb || !ca || !cb) return false;
         if (!ca->isCollidable() || !cb->isCollidable()) return false;
 
-        SDL_FRect rectA{ ta->getPosition().x, ta->getPosition().y, ta->getSize().x, ta->getSize().y };
-        SDL_FRect rectB{ tb->getPosition().x, tb->getPosition().y, tb->getSize().x, tb->getSize().y };
+        return checkCollision(*ta, *tb);
+    }
+
+    // Overlap test on transforms alone, for callers that already walked the collider columns
+    static bool checkCollision(const TransformComponent& ta, const TransformComponent& tb) {
+        SDL_FRect rectA{ ta.getPosition().x, ta.getPosition().y, ta.getSize().x, ta.getSize().y };
+        SDL_FRect rectB{ tb.getPosition().x, tb.getPosition().y, tb.getSize().x, tb.getSize().y };
 
         bool xOverlap = (rectA.x < rectB.x + rectB.w) && (rectA.x + rectA.w > rectB.x);
         bool yOverlap = (rectA.y < rectB.y + rectB.h) && (rectA.y + rectA.h > rectB.y);
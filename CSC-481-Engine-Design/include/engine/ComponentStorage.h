@@ -0,0 +1,279 @@
+#pragma once
+
+#include "Component.h"
+#include "ComponentTypeId.h"
+#include "MemoryStats.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class GameObject;
+class Archetype;
+class Prefab;
+
+// Type-erased operations for one concrete component type.
+// Archetype columns use these to move and destroy components they don't know the type of.
+struct ComponentTypeInfo {
+    using CopyFn = void (*)(void* dst, const void* src);
+
+    uint32_t id;
+    const char* name;
+    size_t size;
+    size_t align;
+    void (*moveConstruct)(void* dst, void* src);
+    CopyFn copyConstruct;   // nullptr when T can't be copied, so it can't be in a Prefab
+    void (*destroy)(void* ptr);
+    Component* (*asComponent)(void* ptr);
+
+    template <typename T>
+    static const ComponentTypeInfo& get() {
+        static const ComponentTypeInfo info{
+            ComponentTypeId<T>::get(),
+            componentTypeName<T>(),
+            sizeof(T),
+            alignof(T),
+            [](void* dst, void* src) { new (dst) T(std::move(*static_cast<T*>(src))); },
+            copyFunction<T>(),
+            [](void* ptr) { static_cast<T*>(ptr)->~T(); },
+            [](void* ptr) -> Component* { return static_cast<T*>(ptr); }
+        };
+        return info;
+    }
+
+private:
+    template <typename T>
+    static CopyFn copyFunction() {
+        if constexpr (std::is_copy_constructible_v<T>) {
+            return [](void* dst, const void* src) { new (dst) T(*static_cast<const T*>(src)); };
+        }
+        else {
+            return nullptr;
+        }
+    }
+};
+
+// Where a GameObject's components currently live, plus a slot table indexed by
+// ComponentTypeId so lookups are a single load instead of a search
+struct EntityRecord {
+    Archetype* archetype = nullptr;
+    uint32_t slot = 0;
+    std::array<Component*, MAX_COMPONENT_TYPES> components{};
+};
+
+// Storage for every entity that has exactly the same set of component types.
+// Components are kept in chunks, one contiguous column per type, so iterating a
+// component type across an archetype walks memory linearly. Slots never move once
+// assigned, so pointers stay valid until the owning object changes its component set.
+class Archetype {
+public:
+    static constexpr uint32_t CHUNK_CAPACITY = 128;   // entities per chunk
+    static constexpr uint32_t MAX_CHUNKS = 1024;      // chunk table is fixed so readers never see it reallocate
+
+    explicit Archetype(std::vector<const ComponentTypeInfo*> types);
+    ~Archetype();
+
+    Archetype(const Archetype&) = delete;
+    Archetype& operator=(const Archetype&) = delete;
+
+    const std::vector<const ComponentTypeInfo*>& getTypes() const { return types; }
+    size_t getColumnCount() const { return types.size(); }
+    ComponentMask getMask() const { return mask; }
+
+    // Column index of a type id, or -1 if this archetype doesn't store it
+    int findColumn(uint32_t typeId) const { return columnOf[typeId]; }
+    bool hasType(uint32_t typeId) const { return (mask >> typeId) & 1; }
+
+    // Reserve a slot for owner. Component memory in the slot is left unconstructed.
+    uint32_t allocateSlot(GameObject* owner);
+
+    // Destroy every component in the slot and return it to the free list
+    void freeSlot(uint32_t slot);
+
+    // Inactive slots keep their owner and components but are skipped by views, so a
+    // parked object can be brought back without touching the allocator
+    bool isActive(uint32_t slot) const {
+        return getActiveFlags(slot / CHUNK_CAPACITY)[slot % CHUNK_CAPACITY].load(std::memory_order_relaxed) != 0;
+    }
+    void setActive(uint32_t slot, bool active) {
+        getActiveFlags(slot / CHUNK_CAPACITY)[slot % CHUNK_CAPACITY].store(active ? 1 : 0, std::memory_order_relaxed);
+    }
+
+    // Raw component memory for column/slot
+    void* getData(int column, uint32_t slot) const {
+        char* chunk = chunks[slot / CHUNK_CAPACITY].load(std::memory_order_acquire);
+        return chunk + columnOffsets[column] + (slot % CHUNK_CAPACITY) * types[column]->size;
+    }
+
+    Component* getComponent(int column, uint32_t slot) const {
+        return types[column]->asComponent(getData(column, slot));
+    }
+
+    // Chunk level access for linear iteration
+    uint32_t getChunkCount() const { return chunkCount.load(std::memory_order_acquire); }
+    GameObject* const* getOwners(uint32_t chunk) const {
+        return reinterpret_cast<GameObject* const*>(chunks[chunk].load(std::memory_order_acquire));
+    }
+    std::atomic<uint8_t>* getActiveFlags(uint32_t chunk) const {
+        return reinterpret_cast<std::atomic<uint8_t>*>(chunks[chunk].load(std::memory_order_acquire) + ACTIVE_OFFSET);
+    }
+    template <typename T>
+    T* getColumn(int column, uint32_t chunk) const {
+        return reinterpret_cast<T*>(chunks[chunk].load(std::memory_order_acquire) + columnOffsets[column]);
+    }
+
+    size_t getLiveCount() const { return liveCount; }
+
+private:
+    // Chunk layout: owner pointers, active flags, then one column per component type
+    static constexpr size_t ACTIVE_OFFSET = CHUNK_CAPACITY * sizeof(GameObject*);
+
+    void addChunk();
+
+    std::vector<const ComponentTypeInfo*> types;   // sorted by type id
+    std::vector<size_t> columnOffsets;             // byte offset of each column inside a chunk
+    ComponentMask mask = 0;
+    std::array<int8_t, MAX_COMPONENT_TYPES> columnOf;
+    size_t chunkBytes = 0;
+    size_t chunkAlign = alignof(std::max_align_t);
+
+    std::unique_ptr<std::atomic<char*>[]> chunks;
+    std::atomic<uint32_t> chunkCount{ 0 };
+    std::vector<uint32_t> freeSlots;
+    size_t liveCount = 0;
+};
+
+// Components of one type summed over every archetype that stores it
+struct ComponentTypeUsage {
+    const ComponentTypeInfo* type = nullptr;
+    size_t liveCount = 0;
+    size_t reservedCount = 0;   // slots in allocated chunks, live or not
+};
+
+// Owns every archetype and moves entities between them as components are added or removed.
+// Structural changes are serialized by a recursive mutex so iteration callbacks can still spawn objects.
+class ComponentStorage {
+public:
+    // Construct a T from args directly in owner's storage, migrating it to the archetype
+    // that includes T. Args must not refer to owner's other components, those move first.
+    template <typename T, typename... Args>
+    static T* emplace(GameObject* owner, EntityRecord& record, Args&&... args) {
+        ScopedLatency timing(MemoryStats::getComponentAllocLatency());
+        std::lock_guard<std::recursive_mutex> lock(getMutex());
+        const ComponentTypeInfo& info = ComponentTypeInfo::get<T>();
+
+        // Replacing an existing component keeps the slot, same as the old map assignment
+        if (record.archetype) {
+            int column = record.archetype->findColumn(info.id);
+            if (column >= 0) {
+                T* existing = static_cast<T*>(record.archetype->getData(column, record.slot));
+                existing->~T();
+                return new (existing) T(std::forward<Args>(args)...);
+            }
+        }
+
+        Archetype* target = findArchetypeWith(record.archetype, &info);
+        migrate(owner, record, target);
+        T* stored = new (target->getData(target->findColumn(info.id), record.slot)) T(std::forward<Args>(args)...);
+        record.components[info.id] = stored;
+        return stored;
+    }
+
+    // Move value into owner's storage
+    template <typename T>
+    static T* add(GameObject* owner, EntityRecord& record, T&& value) {
+        return emplace<T>(owner, record, std::move(value));
+    }
+
+    // Destroy owner's T component, migrating it to the archetype without T
+    template <typename T>
+    static void remove(GameObject* owner, EntityRecord& record) {
+        std::lock_guard<std::recursive_mutex> lock(getMutex());
+        uint32_t id = ComponentTypeId<T>::get();
+        if (!record.archetype || !record.archetype->hasType(id)) return;
+
+        Archetype* target = findArchetypeWithout(record.archetype, id);
+        migrate(owner, record, target);
+    }
+
+    // Give owner a copy of every component in prefab. The prefab's archetype is found once
+    // and cached, so each spawn is one slot plus one copy per component. An owner already
+    // in that archetype (a recycled instance) keeps its slot and is reset in place.
+    static void instantiate(GameObject* owner, EntityRecord& record, const Prefab& prefab);
+
+    // Hide or show an entity's components to views without giving up its slot
+    static void setActive(EntityRecord& record, bool active);
+
+    // Destroy all of an entity's components
+    static void destroy(EntityRecord& record);
+
+    // Call fn(GameObject&, Ts&...) for every active entity that has all of Ts, walking each
+    // archetype's columns chunk by chunk
+    template <typename... Ts, typename Fn>
+    static void forEach(Fn&& fn) {
+        std::lock_guard<std::recursive_mutex> lock(getMutex());
+        const std::vector<Archetype*>& archetypes = getMatchingArchetypes((ComponentTypeId<Ts>::mask() | ...));
+
+        // Indexed loop since fn may create new matching archetypes while we iterate
+        for (size_t a = 0; a < archetypes.size(); a++) {
+            Archetype* archetype = archetypes[a];
+            if (archetype->getLiveCount() == 0) continue;
+
+            const int columns[] = { archetype->findColumn(ComponentTypeId<Ts>::get())... };
+            forEachInArchetype<Ts...>(*archetype, columns, fn, std::index_sequence_for<Ts...>{});
+        }
+    }
+
+    // Every archetype whose component set includes mask. Lists are cached per mask and
+    // extended as new archetypes are created, so repeated queries never rescan.
+    // Caller must hold getMutex() while using the returned list.
+    static const std::vector<Archetype*>& getMatchingArchetypes(ComponentMask mask);
+
+    static std::recursive_mutex& getMutex();
+
+    // Usage indexed by type id for memory telemetry. Entries for types never stored keep a null type.
+    static void getTypeUsage(std::array<ComponentTypeUsage, MAX_COMPONENT_TYPES>& usage);
+
+    // While set, views skip the storage lock. The SystemScheduler sets it while it runs the
+    // non-structural systems, which can't overlap a structural change; it is cleared while
+    // a structural system (and any jobs it fans out to) runs.
+    static void setSharedReads(bool shared);
+    static bool hasSharedReads();
+
+private:
+    template <typename... Ts, typename Fn, size_t... Is>
+    static void forEachInArchetype(Archetype& archetype, const int* columns, Fn& fn, std::index_sequence<Is...>) {
+        uint32_t chunkCount = archetype.getChunkCount();
+        for (uint32_t chunk = 0; chunk < chunkCount; chunk++) {
+            GameObject* const* owners = archetype.getOwners(chunk);
+            std::tuple<Ts*...> data{ archetype.getColumn<Ts>(columns[Is], chunk)... };
+            const std::atomic<uint8_t>* active = archetype.getActiveFlags(chunk);
+            for (uint32_t row = 0; row < Archetype::CHUNK_CAPACITY; row++) {
+                if (!owners[row] || !active[row].load(std::memory_order_relaxed)) continue;
+                fn(*owners[row], std::get<Is>(data)[row]...);
+            }
+        }
+    }
+
+    static Archetype* findArchetypeWith(Archetype* base, const ComponentTypeInfo* added);
+    static Archetype* findArchetypeWithout(Archetype* base, uint32_t removedId);
+    static Archetype* findOrCreateArchetype(std::vector<const ComponentTypeInfo*> types);
+
+    // Move record's shared components into a fresh slot of target and free the old slot
+    static void migrate(GameObject* owner, EntityRecord& record, Archetype* target);
+
+    static std::vector<std::unique_ptr<Archetype>>& getArchetypes();
+
+    struct Query {
+        ComponentMask mask;
+        std::vector<Archetype*> archetypes;
+    };
+    static std::vector<std::unique_ptr<Query>>& getQueries();
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Upper bound on distinct component types, sized so a component set fits in one mask word
+constexpr size_t MAX_COMPONENT_TYPES = 64;
+using ComponentMask = uint64_t;
+
+class ComponentTypeRegistry {
+public:
+    // Hands out the next free id. Aborts if MAX_COMPONENT_TYPES is exceeded.
+    static uint32_t next();
+
+    // Pulls the type out of a __PRETTY_FUNCTION__ / __FUNCSIG__ string from componentTypeName
+    static std::string parseTypeName(const char* signature);
+};
+
+// Readable name of a component type without RTTI, for profiler zones and stats
+template <typename T>
+const char* componentTypeName() {
+#if defined(_MSC_VER)
+    static const std::string name = ComponentTypeRegistry::parseTypeName(__FUNCSIG__);
+#else
+    static const std::string name = ComponentTypeRegistry::parseTypeName(__PRETTY_FUNCTION__);
+#endif
+    return name.c_str();
+}
+
+// Dense per-type id assigned the first time a component type is used.
+// Replaces typeid/type_index lookups so the engine builds without RTTI.
+template <typename T>
+struct ComponentTypeId {
+    static uint32_t get() {
+        static const uint32_t id = ComponentTypeRegistry::next();
+        return id;
+    }
+
+    static ComponentMask mask() { return ComponentMask(1) << get(); }
+};
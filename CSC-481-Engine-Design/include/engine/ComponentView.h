@@ -0,0 +1,99 @@
+#pragma once
+
+#include "ComponentStorage.h"
+#include <atomic>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+class GameObject;
+
+// Range over every active entity that has all of Ts, yielding std::tuple<GameObject&, Ts&...>.
+// Only archetypes from the cached query are visited, so objects missing a component are
+// never looked at. Holds the storage lock for its lifetime (except inside scheduled systems,
+// see ComponentStorage::setSharedReads), so keep views short lived and don't call
+// Engine::removeGameObject from inside the loop (queueRemove is fine).
+template <typename... Ts>
+class ComponentView {
+public:
+    using Tuple = std::tuple<GameObject&, Ts&...>;
+
+    ComponentView()
+        : lock(ComponentStorage::getMutex(), std::defer_lock),
+          archetypes(&ComponentStorage::getMatchingArchetypes((ComponentTypeId<Ts>::mask() | ...))) {
+        if (!ComponentStorage::hasSharedReads()) lock.lock();
+    }
+
+    class Iterator {
+    public:
+        Iterator(const std::vector<Archetype*>* archetypes, bool end)
+            : archetypes(archetypes), archetypeIndex(end ? SIZE_MAX : 0) {
+            if (!end) seek();
+        }
+
+        Tuple operator*() const { return deref(std::index_sequence_for<Ts...>{}); }
+
+        Iterator& operator++() {
+            row++;
+            seek();
+            return *this;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            if (done() || other.done()) return done() != other.done();
+            return archetypeIndex != other.archetypeIndex || chunk != other.chunk || row != other.row;
+        }
+
+    private:
+        bool done() const { return archetypeIndex >= archetypes->size(); }
+
+        // Advance to the next occupied row, starting at the current one
+        void seek() {
+            while (archetypeIndex < archetypes->size()) {
+                Archetype* archetype = (*archetypes)[archetypeIndex];
+                while (archetype->getLiveCount() > 0 && chunk < archetype->getChunkCount()) {
+                    if (!owners) loadChunk(*archetype);
+                    for (; row < Archetype::CHUNK_CAPACITY; row++) {
+                        if (owners[row] && active[row].load(std::memory_order_relaxed)) return;
+                    }
+                    chunk++;
+                    row = 0;
+                    owners = nullptr;
+                }
+                archetypeIndex++;
+                chunk = 0;
+                row = 0;
+                owners = nullptr;
+            }
+        }
+
+        void loadChunk(Archetype& archetype) {
+            owners = archetype.getOwners(chunk);
+            active = archetype.getActiveFlags(chunk);
+            columns = std::tuple<Ts*...>{
+                archetype.getColumn<Ts>(archetype.findColumn(ComponentTypeId<Ts>::get()), chunk)...
+            };
+        }
+
+        template <size_t... Is>
+        Tuple deref(std::index_sequence<Is...>) const {
+            return Tuple(*owners[row], std::get<Is>(columns)[row]...);
+        }
+
+        const std::vector<Archetype*>* archetypes;
+        size_t archetypeIndex;
+        uint32_t chunk = 0;
+        uint32_t row = 0;
+        GameObject* const* owners = nullptr;
+        const std::atomic<uint8_t>* active = nullptr;
+        std::tuple<Ts*...> columns;
+    };
+
+    Iterator begin() const { return Iterator(archetypes, false); }
+    Iterator end() const { return Iterator(archetypes, true); }
+
+private:
+    std::unique_lock<std::recursive_mutex> lock;
+    const std::vector<Archetype*>* archetypes;
+};
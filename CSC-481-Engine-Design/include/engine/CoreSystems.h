@@ -0,0 +1,67 @@
+#pragma once
+
+#include "System.h"
+#include "Engine.h"
+#include "GravityComponent.h"
+#include "TransformComponent.h"
+
+// Applies every GravityComponent to its object's velocity
+class GravitySystem : public System {
+public:
+    GravitySystem() : System("Gravity") {
+        reads<GravityComponent>();
+        writes<TransformComponent>();
+        replaces<GravityComponent>();
+    }
+
+    void update(float deltaTime) override {
+        for (auto [obj, gravity, transform] : Engine::view<GravityComponent, TransformComponent>()) {
+            if (obj.isPaused() || obj.isRemovalQueued()) continue;
+            gravity.update(obj, deltaTime);
+        }
+    }
+};
+
+// Moves every TransformComponent by its velocity. Registered after GravitySystem so it
+// sees this frame's velocity.
+class MovementSystem : public System {
+public:
+    MovementSystem() : System("Movement") {
+        writes<TransformComponent>();
+        replaces<TransformComponent>();
+    }
+
+    void update(float deltaTime) override {
+        for (auto [obj, transform] : Engine::view<TransformComponent>()) {
+            if (obj.isPaused() || obj.isRemovalQueued()) continue;
+            transform.update(obj, deltaTime);
+        }
+    }
+};
+
+// Runs Component::update for every component type no other system replaces. Components
+// can do anything from there, spawning included, so this runs alone but fans the objects
+// out over the job system.
+class ComponentUpdateSystem : public System {
+public:
+    ComponentUpdateSystem() : System("ComponentUpdate") {
+        setStructural();
+    }
+
+    void update(float deltaTime) override {
+        ObjectList::View objects = Engine::getGameObjects();
+        JobSystem::parallel_for(0, objects.size(), GRAIN, [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; i++) {
+                GameObject* obj = objects[i];
+
+                // Skip if object is pending removal
+                if (obj->isRemovalQueued()) continue;
+
+                obj->update(deltaTime);
+            }
+        });
+    }
+
+private:
+    static constexpr size_t GRAIN = 64;   // objects per job
+};
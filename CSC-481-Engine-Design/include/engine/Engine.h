@@ -1,12 +1,25 @@
 #pragma once
 
 #include "GameObject.h"
+#include "ComponentView.h"
+#include "ObjectList.h"
+#include "JobSystem.h"
+#include "SystemScheduler.h"
+#include "FramePacer.h"
+#include "Profiler.h"
+#include "FrameArena.h"
+#include "MemoryStats.h"
+#include "Prefab.h"
+#include "SpriteBatch.h"
 #include <SDL3/SDL.h>
 #include <functional>
+#include <memory>
 #include <vector>
 #include <thread>
 #include <mutex>
 #include <atomic>
+#include <string>
+#include <unordered_map>
 
 // The core engine class. It manages the game loop, window, renderer, and entities.
 class Engine {
@@ -16,30 +29,118 @@ public:
         const char* title;
         int width;
         int height;
+        unsigned workerThreads = 0;   // Job system workers, 0 = one per spare hardware thread
+        float fixedStepHz = 0.0f;     // Simulation rate, 0 = one variable step per frame
+        int maxCatchUpSteps = 5;      // Fixed steps allowed per frame before dropping time
+        float targetFps = 0.0f;       // Frame rate cap, 0 = unpaced
+
+        // No window, renderer or textures. Frames run back to back, each advancing the
+        // simulation by the fixed step (or 1/60 s without one) regardless of wall time.
+        bool headless = false;
+        int maxFrames = 0;            // run() returns after this many frames, 0 = until quit
+
+        size_t frameArenaBytes = 256 * 1024;  // Starting size of the per-frame arena, grows if a frame overflows it
+
+        // MemoryStats report written by shutdown() once every engine-owned object is destroyed,
+        // so anything still live in it leaked. nullptr = no report.
+        const char* memoryReportPath = nullptr;
+
+        // Time every GameObject create and component emplace into MemoryStats. Costs more than
+        // a pooled create, so leave it off unless measuring. MemoryStats::setLatencySampling
+        // toggles it later.
+        bool sampleAllocLatency = false;
     };
     
 	// Runs the main game loop.
 	static void run(std::function<void(float)> update, std::function<void(void)> render);
 
-	// GameObject management
-	static void addGameObject(GameObject* obj);
-	static void removeGameObject(GameObject* obj);
-	static void queueRemove(GameObject* obj);
+	// GameObject management. The engine owns added objects, everything else refers to them by handle.
+	static EntityHandle addGameObject(GameObject* obj);
+	static void removeGameObject(EntityHandle handle);
+	static void queueRemove(EntityHandle handle);
+
+	// Lock free view of the objects published at the last frame boundary. Objects added
+	// since then show up next frame; check isRemovalQueued() to skip doomed ones.
+	static ObjectList::View getGameObjects() { return s_publishedObjects.read(); }
 	static std::vector<GameObject*> getGameObjectsSnapshot();
+
+	// Scratch memory that is reclaimed at the start of the next frame. Use it for containers
+	// built and thrown away within a frame so they never touch the heap. Not for anything
+	// queued past the frame, such as events raised on an EventManager.
+	static std::pmr::memory_resource* getFrameAllocator();
+	static const FrameArena* getFrameArena() { return s_frameArena.get(); }
+
+	// Look up a handle, nullptr if the object has been destroyed
+	static GameObject* resolve(EntityHandle handle) { return EntityRegistry::resolve(handle); }
 	static std::mutex& getGameObjectsMutex();
 
-    // Memory pool configuration
+	// Iterate every object that has all of Ts as (GameObject&, Ts&...) tuples
+	template <typename... Ts>
+	static ComponentView<Ts...> view() { return ComponentView<Ts...>(); }
+
+	// Register a System. Systems run every frame after the update callback, in parallel
+	// where their declared component access allows it.
+	template <typename T, typename... Args>
+	static T* addSystem(Args&&... args) {
+		auto system = std::make_unique<T>(std::forward<Args>(args)...);
+		T* added = system.get();
+		SystemScheduler::add(std::move(system));
+		return added;
+	}
+
+    // Memory pool configuration. The pool grows by chunks of poolCapacity objects.
     static void usePoolAllocator(bool usePool, size_t poolCapacity = 100);
     
     // Create GameObject with current allocator
     static GameObject* createGameObject();
+
+    // Prefab registry. Define prefabs during setup, after init() since render components
+    // load their textures then; they are destroyed by shutdown(). Lookups are locked, but a
+    // prefab must not be changed once objects spawn from it, so keep the Prefab* rather than
+    // looking it up per spawn.
+    static Prefab& definePrefab(const std::string& name);
+    static Prefab* getPrefab(const std::string& name);
+
+    // Spawn a copy of prefab, reusing a parked instance when the prefab recycles and one is
+    // available, otherwise from the current allocator. overrides(GameObject&) runs before
+    // the object is added, re-emplace components there to set per-instance state.
+    template <typename Fn>
+    static GameObject* instantiate(Prefab& prefab, Fn&& overrides) {
+        GameObject* obj = spawnPrefab(prefab);
+        if (!obj) return nullptr;
+        overrides(*obj);
+        addGameObject(obj);
+        return obj;
+    }
+    static GameObject* instantiate(Prefab& prefab) {
+        return instantiate(prefab, [](GameObject&) {});
+    }
     
     // Get pool statistics
     static float getPoolUsagePercent();
     static size_t getPoolCapacity();
+    static size_t getPoolHighWaterMark();
     
-	// Getter for the renderer.
+	// Getter for the renderer. nullptr when headless. Only the main thread may render with it.
 	static SDL_Renderer* getRenderer();
+	static bool isHeadless() { return s_headless; }
+
+	// True on the thread that called init()
+	static bool isMainThread() { return std::this_thread::get_id() == s_mainThread; }
+
+	// Visible area in world coordinates for a camera whose top-left is at cameraOffset, sized
+	// to the current render output (the window is resizable). Empty when headless.
+	static SDL_FRect getViewRect(const Vec2& cameraOffset = Vec2{ 0.f, 0.f });
+
+	// Batch for the render callback. Queue sprites, flush it before drawing the HUD;
+	// anything still queued is flushed after the callback returns.
+	static SpriteBatch& getSpriteBatch() { return s_spriteBatch; }
+
+	// How far between the last two fixed steps this frame is drawn, 0..1 (always 1 with a variable step)
+	static float getInterpolationAlpha() { return s_interpolationAlpha; }
+
+	// Frames that started after their pacing deadline had already passed
+	static uint64_t getMissedFrames() { return s_missedFrames; }
 
     // Initializes the engine
 	static bool init(const Config& cfg);
@@ -52,14 +153,58 @@ private:
 	// Private members for the engine's core functionality.
 	static SDL_Window* s_window;
 	static SDL_Renderer* s_renderer;
+	static SpriteBatch s_spriteBatch;
 	static bool s_running;
 
+	// Fixed timestep, 0 when stepping once per frame
+	static double s_fixedStep;
+	static int s_maxCatchUpSteps;
+	static float s_interpolationAlpha;
+
+	// Frame pacing
+	static float s_targetFps;
+	static bool s_headless;
+	static std::thread::id s_mainThread;
+	static int s_maxFrames;
+	static uint64_t s_missedFrames;
+
+	static std::unique_ptr<FrameArena> s_frameArena;
+	static const char* s_memoryReportPath;
+
+	static std::unordered_map<std::string, std::unique_ptr<Prefab>> s_prefabs;
+	static std::mutex s_prefabsMutex;
+	static GameObject* spawnPrefab(Prefab& prefab);
+
+	// Final step of a removal, once no reader can see obj: park it with its prefab if that
+	// recycles, destroy it otherwise
+	static void retireGameObject(GameObject* obj);
+
+	// One simulation step: update callback, systems, removal flush
+	static void step(const std::function<void(float)>& update, float deltaTime);
+
 	// Game object tracking
 	static std::vector<GameObject*> s_gameObjects;
 	static std::mutex s_gameObjectsMutex;
-	static std::vector<GameObject*> s_pendingRemovals;
+	static std::vector<EntityHandle> s_pendingRemovals;
+
+	// Where each engine-owned object sits in s_gameObjects, indexed by EntityHandle::index.
+	// Lets removal swap-and-pop in O(1).
+	static constexpr uint32_t NOT_OWNED = UINT32_MAX;
+	struct ObjectSlot {
+		uint32_t denseIndex = NOT_OWNED;
+	};
+	static std::vector<ObjectSlot> s_objectSlots;
+
+	// Readers' copy of s_gameObjects, republished when it changes
+	static ObjectList s_publishedObjects;
+	static bool s_objectsDirty;
+
+	// These expect s_gameObjectsMutex to be held
+	static ObjectSlot* findSlot(GameObject* obj);
+	static void unlinkGameObject(GameObject* obj);
+	static void publishGameObjects();
 
-	// Multithreading private members
-	static std::thread s_updateThread;
-	static std::atomic<bool> s_workerRunning;
+	// Unlinks everything queued this frame, publishes, waits out readers still holding
+	// the old list, then destroys the batch outside the lock
+	static void flushRemovals();
 };
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+class GameObject;
+
+// Generational reference to a GameObject. The index picks a slot in the EntityRegistry,
+// the generation must match the slot's current generation, so a handle to a destroyed
+// object resolves to nullptr even after its slot (or pool memory) is reused.
+struct EntityHandle {
+    uint32_t index = 0;
+    uint32_t generation = 0;   // 0 is never handed out, so a default handle is null
+
+    bool isValid() const { return generation != 0; }
+
+    bool operator==(const EntityHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+
+    // Compact form for events and network messages
+    uint64_t pack() const { return (static_cast<uint64_t>(generation) << 32) | index; }
+    static EntityHandle unpack(uint64_t packed) {
+        return EntityHandle{ static_cast<uint32_t>(packed), static_cast<uint32_t>(packed >> 32) };
+    }
+};
+
+// Maps handles to live objects. Every GameObject registers itself on construction and
+// releases its slot on destruction. resolve() is lock free and O(1).
+class EntityRegistry {
+public:
+    static EntityHandle create(GameObject* obj);
+    static void release(EntityHandle handle);
+
+    // The object a handle refers to, or nullptr if it has been destroyed
+    static GameObject* resolve(EntityHandle handle);
+
+private:
+    static constexpr uint32_t CHUNK_SIZE = 4096;
+    static constexpr uint32_t MAX_CHUNKS = 256;   // ~1M live objects
+
+    struct Slot {
+        std::atomic<GameObject*> object{ nullptr };
+        std::atomic<uint32_t> generation{ 1 };
+    };
+
+    static Slot* getSlot(uint32_t index);
+
+    // Chunks never move once allocated, so resolve() can read them without the lock
+    static std::atomic<Slot*> chunks[MAX_CHUNKS];
+    static uint32_t slotCount;
+    static std::vector<uint32_t> freeSlots;
+    static std::mutex mutex;
+};
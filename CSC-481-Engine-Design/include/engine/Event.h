@@ -2,27 +2,26 @@
 #include <string>
 #include <map>
 #include <memory>
-
-class GameObject;  // Forward declare
+#include "EntityHandle.h"
 
 struct Variant {
 	enum class Type {
 		INT,
 		FLOAT,
-		GAMEOBJECT,
+		ENTITY,
 		// Add more as needed
 	} type;
 
 	union {
 		int asInt;
 		float asFloat;
-		GameObject* asGameObject;
+		EntityHandle asEntity;
 	};
 
 	Variant() : type(Type::INT), asInt(0) {}
 	Variant(int v) : type(Type::INT), asInt(v) {}
 	Variant(float v) : type(Type::FLOAT), asFloat(v) {}
-	Variant(GameObject* obj) : type(Type::GAMEOBJECT), asGameObject(obj) {}
+	Variant(EntityHandle handle) : type(Type::ENTITY), asEntity(handle) {}
 };
 
 class Event {
@@ -47,4 +46,10 @@ public:
 		}
 		return Variant(); // default
 	}
+
+	// Entity parameter, or a null handle if missing or not an entity
+	EntityHandle getEntity(const std::string& key) const {
+		Variant v = getParam(key);
+		return v.type == Variant::Type::ENTITY ? v.asEntity : EntityHandle{};
+	}
 };
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+// Linear allocator for memory that only has to live until the end of the frame. Allocation
+// is a lock-free pointer bump, so jobs on any thread can use it; deallocate does nothing and
+// reset() reclaims everything at once. A frame that runs past the buffer spills to the heap,
+// and the next reset grows the buffer so the steady state makes no heap allocations.
+//
+// Hand it to pmr containers: std::pmr::vector<T> v(Engine::getFrameAllocator());
+// Only the container's own storage comes from the arena. Elements that own heap memory keep
+// allocating: the one user today, the platformer's per-frame event list, still allocates
+// each Event's name and parameter map.
+class FrameArena : public std::pmr::memory_resource {
+public:
+    explicit FrameArena(size_t capacity);
+    ~FrameArena() override;
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // Invalidates everything allocated since the last reset. No allocations may be in flight.
+    void reset();
+
+    size_t getCapacity() const { return capacity; }
+    size_t getUsedBytes() const;
+    size_t getPeakBytes() const { return peakBytes; }       // most bytes any frame used
+    size_t getOverflowCount() const { return overflowCount; } // frames that spilled to the heap
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    struct Spill {
+        void* ptr;
+        size_t bytes;
+        size_t alignment;
+    };
+
+    char* buffer = nullptr;
+    size_t capacity = 0;
+    std::atomic<size_t> offset{ 0 };
+
+    std::mutex spillMutex;
+    std::vector<Spill> spills;
+    size_t spilledBytes = 0;
+
+    size_t peakBytes = 0;
+    size_t overflowCount = 0;
+};
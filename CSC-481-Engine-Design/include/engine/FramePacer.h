@@ -0,0 +1,37 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+// Paces a loop to a target rate against absolute deadlines, so the time a tick spends
+// working doesn't push every later tick back. Sleeps through most of the wait and spins
+// the last stretch, since OS sleeps can overshoot by a scheduler quantum.
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // 0 Hz leaves the loop unpaced, wait() then only measures
+    explicit FramePacer(double targetHz = 0.0,
+                        std::chrono::nanoseconds spinWindow = std::chrono::microseconds(1500));
+
+    void setTargetRate(double hz);
+    double getTargetRate() const { return targetHz; }
+
+    // Block until the next deadline and return the seconds since the previous wait() returned
+    double wait();
+
+    // Deadlines that had already passed when wait() was called
+    uint64_t getMissedDeadlines() const { return missedDeadlines; }
+    uint64_t getFrameCount() const { return frameCount; }
+
+private:
+    double targetHz = 0.0;
+    Clock::duration period{ 0 };
+    Clock::duration spinWindow;
+
+    Clock::time_point deadline;
+    Clock::time_point lastReturn;
+
+    uint64_t missedDeadlines = 0;
+    uint64_t frameCount = 0;
+};
@@ -1,67 +1,102 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
-#include <map>
 #include <string>
-#include <typeindex>
-#include <typeinfo>
+#include <type_traits>
 
 #include <SDL3/SDL.h>
 #include "Component.h"
+#include "ComponentStorage.h"
+#include "EntityHandle.h"
+#include "Profiler.h"
 #include "RenderComponent.h"
+#include "SystemScheduler.h"
 
+// A GameObject is a thin handle: its components live in the archetype storage,
+// grouped with every other object that has the same component set.
 class GameObject {
 public:
     void setPaused(bool p) { paused = p; }
     bool isPaused() const { return paused; }
 
-    GameObject() = default;
-    ~GameObject() = default;
+    // Generational handle for this object, safe to hold after it is destroyed
+    EntityHandle getHandle() const { return handle; }
 
-    // Add a component of type T
+    // Set once Engine::queueRemove accepts this object, read lock free by the update loop
+    bool isRemovalQueued() const { return removalQueued.load(std::memory_order_acquire); }
+
+    GameObject() : handle(EntityRegistry::create(this)) {}
+    ~GameObject() {
+        ComponentStorage::destroy(record);
+        EntityRegistry::release(handle);
+    }
+
+    GameObject(const GameObject&) = delete;
+    GameObject& operator=(const GameObject&) = delete;
+
+    // Construct a component of type T in place in archetype storage, with no heap
+    // allocation of its own. Pointers to this object's other components are invalidated.
+    template <typename T, typename... Args>
+    T* emplaceComponent(Args&&... args) {
+        T* stored = ComponentStorage::emplace<T>(this, record, std::forward<Args>(args)...);
+        stored->onAdd(*this);  // Inform the component of its owner
+        return stored;
+    }
+
+    // Add an already built component of type T. It is moved into archetype storage,
+    // so pointers to this object's other components are invalidated.
+    // comp must hold exactly a T: storage keeps values by static type, so a derived
+    // component passed through a unique_ptr to its base is sliced down to the base and
+    // stored under the base's id. Pass the concrete type, or use emplaceComponent.
     template <typename T>
     void addComponent(std::unique_ptr<T> comp) {
-        std::type_index key(typeid(T));
-        comp->onAdd(*this);  // Inform the component of its owner
-        components[key] = std::move(comp);
+        static_assert(!std::is_abstract_v<T>, "addComponent needs the concrete component type, not a base");
+        static_assert(std::is_move_constructible_v<T>, "components are moved into archetype storage");
+        T* stored = ComponentStorage::add<T>(this, record, std::move(*comp));
+        stored->onAdd(*this);  // Inform the component of its owner
     }
 	
 	// Remove a component of type T
 	template <typename T>
 	void removeComponent() {
-		std::type_index key(typeid(T));
-		auto it = components.find(key);
-		if (it != components.end()) {
-			components.erase(it);
-		}
+		ComponentStorage::remove<T>(this, record);
 	}
 
 	// Has component function
 	template <typename T>
 	bool hasComponent() const {
-		std::type_index key(typeid(T));
-		return components.find(key) != components.end();
+		return record.components[ComponentTypeId<T>::get()] != nullptr;
 	}
 
-    // Get component of type T, or nullptr if not present
+    // Get component of type T, or nullptr if not present.
+    // The slot for T's id can only ever hold a T, so no dynamic_cast is needed.
     template <typename T>
     T* getComponent() {
-        std::type_index key(typeid(T));
-        auto it = components.find(key);
-        if (it != components.end()) {
-            return dynamic_cast<T*>(it->second.get());
-        }
-        return nullptr;
+        return static_cast<T*>(record.components[ComponentTypeId<T>::get()]);
     }
 
-    // Update all components
-    void update(float deltaTime) {
-    if (paused) return;
+	// Update all components
+	void update(float deltaTime) {
+		if (paused) return;
 
-    for (auto& [_, comp] : components) {
-        comp->update(*this, deltaTime);
-    }
-}
+		Archetype* archetype = record.archetype;
+		if (!archetype) return;
+
+		// Types driven by a registered System are updated there instead
+		ComponentMask replaced = SystemScheduler::getReplacedMask();
+
+		for (size_t column = 0; column < archetype->getColumnCount(); column++) {
+			const ComponentTypeInfo* type = archetype->getTypes()[column];
+			if ((replaced >> type->id) & 1) continue;
+
+			ENGINE_PROFILE_SCOPE(type->name);
+			archetype->getComponent(static_cast<int>(column), record.slot)->update(*this, deltaTime);
+
+			// A component changed this object's component set, the remaining columns moved
+			if (record.archetype != archetype) break;
+		}
+	}
 
     // Draw all components
 	void draw(SDL_Renderer* renderer) {
@@ -77,6 +112,17 @@ public:
 	}
 
 private:
-    std::map<std::type_index, std::unique_ptr<Component>> components;
+    EntityHandle handle;
+    EntityRecord record;
     bool paused = false;
+    std::atomic<bool> removalQueued{ false };
+
+    // Set by GameObjectAllocator when the object lives in pool memory
+    bool pooled = false;
+
+    // Prefab this object was instantiated from, where it is parked if the prefab recycles
+    Prefab* prefab = nullptr;
+
+    friend class Engine;
+    friend class GameObjectAllocator;
 };
@@ -1,7 +1,13 @@
 #pragma once
 #include "GameObjectPool.hpp"
+#include "MemoryStats.h"
+#include <atomic>
 #include <memory>
 
+// Creates and destroys GameObjects from any engine thread. In POOLED mode each thread keeps
+// a magazine of free pool slots, so most creates and destroys never leave the thread. Full
+// and empty magazines are swapped through a lock-free depot, and the pool's lock is only
+// taken to refill or drain a magazine.
 class GameObjectAllocator {
 public:
     enum AllocMode {
@@ -9,24 +15,44 @@ public:
         POOLED     // Use pool allocator
     };
 
+    // Setup calls, make them before objects are created from other threads
     static void setMode(AllocMode mode) { allocationMode = mode; }
-    static void setPoolCapacity(size_t capacity) {
-        if (!pool) {
-            pool = std::make_unique<GameObjectPool>(capacity);
-        }
+    static void setPoolCapacity(size_t capacity);   // objects per pool chunk
+    static void setPoolMaxEmptyChunks(size_t count) {
+        if (pool) pool->setMaxEmptyChunks(count);
     }
 
     static GameObject* create();
     static void destroy(GameObject* obj);
-    
-    static float getPoolUsagePercent() {
-        return pool ? pool->getUsagePercent() : 0.0f;
-    }
+
+    static float getPoolUsagePercent();
     static size_t getPoolCapacity() {
         return pool ? pool->getCapacity() : 0;
     }
+    static size_t getPoolUsedCount() {
+        return liveCount.load(std::memory_order_relaxed);
+    }
+    static size_t getPoolHighWaterMark() {
+        return highWaterMark.load(std::memory_order_relaxed);
+    }
+    static size_t getPoolChunkCount() {
+        return pool ? pool->getChunkCount() : 0;
+    }
+
+    // create() calls that returned nullptr
+    static uint64_t getFailedAllocations() {
+        return failedAllocations.load(std::memory_order_relaxed);
+    }
 
 private:
+    static void* takeSlot();
+    static void returnSlot(void* slot);
+
     static AllocMode allocationMode;
     static std::unique_ptr<GameObjectPool> pool;
+
+    // Pooled objects only
+    static std::atomic<size_t> liveCount;
+    static std::atomic<size_t> highWaterMark;
+    static std::atomic<uint64_t> failedAllocations;
 };
\ No newline at end of file
@@ -1,26 +1,80 @@
 #pragma once
 #include "GameObject.h"
 #include <cstring>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
 
+// Slots for GameObjects, carved from fixed-size chunks. A full pool grows by another chunk
+// instead of failing, and existing objects never move. Slots are handed out as raw memory,
+// GameObjectAllocator constructs and destroys the objects in them and caches slots per thread.
 class GameObjectPool {
 public:
-    GameObjectPool(size_t capacity);
+    // chunkCapacity is a lower bound, chunks are rounded up to a power of two in bytes so a
+    // chunk can be found from any address inside it. maxChunks 0 lets the pool grow freely.
+    GameObjectPool(size_t chunkCapacity, size_t maxChunks = 0);
     ~GameObjectPool();
 
     GameObjectPool(const GameObjectPool&) = delete;
     GameObjectPool& operator=(const GameObjectPool&) = delete;
 
-    GameObject* allocate();
-    void deallocate(GameObject* obj);
-    bool owns(GameObject* obj) const;
+    // One slot of sizeof(GameObject) bytes, or nullptr once maxChunks is reached
+    void* allocate();
+    void deallocate(void* slot);
 
-    float getUsagePercent() const;
-    size_t getCapacity() const { return capacity; }
-    size_t getUsedCount() const { return usedCount; }
+    // Batched versions that take the lock once. allocate returns how many slots it filled.
+    size_t allocate(void** slots, size_t count);
+    void deallocate(void* const* slots, size_t count);
+
+    bool owns(const void* slot) const;
+
+    // Chunks left empty by deallocate are kept for reuse up to this many, the rest are freed
+    void setMaxEmptyChunks(size_t count);
+
+    size_t getCapacity() const;
+    size_t getChunkCount() const;
+    size_t getChunkCapacity() const { return objectsPerChunk; }
+
+    // Slots currently handed out, including any sitting in an allocator cache
+    size_t getUsedCount() const;
 
 private:
-    size_t capacity;
-    size_t usedCount;
-    char* memory;
-    bool* used;
+    static constexpr size_t NO_SLOT = static_cast<size_t>(-1);
+
+    struct Chunk {
+        char* memory;
+        bool* used;
+        size_t usedCount = 0;
+
+        // Free slots are linked through their own storage, each holding the next free index
+        size_t freeHead = NO_SLOT;
+
+        // Links in the list of chunks that still have a free slot
+        Chunk* prevAvailable = nullptr;
+        Chunk* nextAvailable = nullptr;
+        bool available = false;
+    };
+
+    Chunk* addChunk();
+    void releaseChunk(Chunk* chunk);
+    Chunk* findChunk(const void* address) const;
+    void* allocateLocked();
+    void deallocateLocked(void* slot);
+    void linkAvailable(Chunk* chunk);
+    void unlinkAvailable(Chunk* chunk);
+
+    size_t chunkBytes;
+    size_t objectsPerChunk;
+    size_t maxChunks;
+    size_t maxEmptyChunks = 1;
+
+    size_t usedCount = 0;
+    size_t emptyChunks = 0;
+
+    // Keyed by chunk base address, chunks are aligned to chunkBytes
+    std::unordered_map<uintptr_t, Chunk*> chunks;
+    Chunk* availableHead = nullptr;
+
+    // Only taken to refill or drain an allocator cache, or when a thread has no cache
+    mutable std::mutex mutex;
 };
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Engine-wide worker pool. Every worker owns a deque: it pushes and pops its own jobs
+// at the back and steals from the front of the others' when it runs dry. Threads that
+// are not workers (main, update) share one extra queue and help out while they wait.
+class JobSystem {
+public:
+    // Counts outstanding jobs, wait() returns once it reaches zero
+    using Counter = std::atomic<int>;
+
+    // 0 workers means one per hardware thread, minus the calling thread
+    static void init(unsigned workerCount = 0);
+    static void shutdown();
+
+    static unsigned getWorkerCount();
+
+    // Queue fn(context) and bump counter, which is decremented when it has run
+    static void submit(void (*fn)(void*), void* context, Counter& counter);
+
+    // Run other jobs until counter drops to zero
+    static void wait(Counter& counter);
+
+    // Calls fn(first, last) over [begin, end) split into ranges of at most grain items,
+    // spread over the workers. Blocks until every range has run.
+    template <typename Fn>
+    static void parallel_for(size_t begin, size_t end, size_t grain, const Fn& fn);
+
+private:
+    struct Job {
+        void (*fn)(void*);
+        void* context;
+        Counter* counter;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    static void workerLoop(unsigned index);
+    static bool tryRunOne();
+    static bool popLocal(Job& job);
+    static bool steal(Job& job);
+    static void run(const Job& job);
+
+    // Queue 0 is shared by non-worker threads, worker i owns queue i + 1
+    static std::vector<Queue*> s_queues;
+    static std::vector<std::thread> s_workers;
+    static std::atomic<bool> s_running;
+
+    // Sleeping workers wait here while nothing is queued
+    static std::atomic<int> s_queuedJobs;
+    static std::mutex s_sleepMutex;
+    static std::condition_variable s_wake;
+};
+
+template <typename Fn>
+void JobSystem::parallel_for(size_t begin, size_t end, size_t grain, const Fn& fn) {
+    if (begin >= end) return;
+    if (grain == 0) grain = 1;
+
+    // Too little work, or nobody to share it with
+    if (end - begin <= grain || s_workers.empty()) {
+        fn(begin, end);
+        return;
+    }
+
+    struct Range {
+        const Fn* fn;
+        size_t first;
+        size_t last;
+    };
+
+    size_t count = (end - begin + grain - 1) / grain;
+    std::vector<Range> ranges(count);
+    Counter counter{ 0 };
+
+    // Keep the first range for this thread, hand out the rest
+    for (size_t i = 1; i < count; i++) {
+        size_t first = begin + i * grain;
+        ranges[i] = Range{ &fn, first, first + grain < end ? first + grain : end };
+        submit([](void* context) {
+            Range* range = static_cast<Range*>(context);
+            (*range->fn)(range->first, range->last);
+        }, &ranges[i], counter);
+    }
+
+    fn(begin, begin + grain);
+    wait(counter);
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Power-of-two buckets of nanosecond durations, fed from any thread. Off until enabled:
+// timing costs two clock reads and every thread's samples land on the same counters, which
+// is more than a magazine create, so only sample while measuring.
+class LatencyHistogram {
+public:
+    static constexpr size_t BUCKETS = 32;   // bucket i holds durations below 2^i ns
+
+    void setEnabled(bool on) { enabled.store(on, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    void record(uint64_t nanoseconds) {
+        size_t bucket = 0;
+        while (bucket + 1 < BUCKETS && (uint64_t(1) << bucket) <= nanoseconds) bucket++;
+        counts[bucket].fetch_add(1, std::memory_order_relaxed);
+        total.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t getCount() const { return total.load(std::memory_order_relaxed); }
+    uint64_t getBucket(size_t bucket) const { return counts[bucket].load(std::memory_order_relaxed); }
+
+    // Upper bound of the bucket holding the given fraction (0..1) of samples, 0 if empty
+    uint64_t percentile(double fraction) const;
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKETS> counts{};
+    std::atomic<uint64_t> total{ 0 };
+    std::atomic<bool> enabled{ false };
+};
+
+// Times a scope into a LatencyHistogram, without reading the clock if it is disabled
+class ScopedLatency {
+public:
+    explicit ScopedLatency(LatencyHistogram& histogram)
+        : histogram(histogram.isEnabled() ? &histogram : nullptr) {
+        if (this->histogram) start = std::chrono::steady_clock::now();
+    }
+    ~ScopedLatency() {
+        if (!histogram) return;
+        histogram->record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count()));
+    }
+
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+private:
+    LatencyHistogram* histogram;
+    std::chrono::steady_clock::time_point start;
+};
+
+// Engine-wide memory telemetry: live components per type, GameObject pool occupancy, the
+// frame arena, failed allocations and allocation latency. Everything is read on demand from
+// the owning allocators; sample() only tracks the per-type peaks between reports.
+class MemoryStats {
+public:
+    struct ComponentTypeStats {
+        const char* name;
+        size_t size;            // bytes per component
+        size_t liveCount;
+        size_t liveBytes;
+        size_t reservedBytes;   // archetype chunk memory held for this type
+        size_t peakCount;       // most seen live at a sample()
+    };
+
+    struct PoolStats {
+        size_t capacity;
+        size_t used;
+        size_t highWaterMark;
+        size_t chunks;
+        uint64_t failedAllocations;
+    };
+
+    struct ArenaStats {
+        size_t capacity;
+        size_t usedBytes;
+        size_t peakBytes;
+        size_t overflowFrames;
+    };
+
+    static std::vector<ComponentTypeStats> getComponentTypeStats();
+    static PoolStats getObjectPoolStats();
+    static ArenaStats getFrameArenaStats();
+
+    // GameObjectAllocator::create and ComponentStorage::emplace. Empty unless sampling is on.
+    static LatencyHistogram& getObjectAllocLatency();
+    static LatencyHistogram& getComponentAllocLatency();
+    static void setLatencySampling(bool enabled);
+    static bool isLatencySampling();
+
+    // Called once per frame by the engine to update the per-type peaks
+    static void sample();
+
+    // Plain text report of everything above. Returns false if the file can't be opened.
+    static bool writeReport(const char* path);
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include <vector>
+#include <memory_resource>
 #include "TransformComponent.h"
 #include "Event.h"
 
@@ -10,7 +11,7 @@ struct ClientCommand {
 	int tick;
 	float x;
 	float y;
-	std::vector<Event> events;
+	std::pmr::vector<Event> events;  // storage usually in the frame arena, each Event still owns heap memory
 };
 
 // Stored on the server
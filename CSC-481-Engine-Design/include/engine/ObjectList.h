@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class GameObject;
+
+// Read-mostly list of game objects published RCU style. The writer builds the next
+// version and swaps it in, readers pin the current version and iterate it without
+// taking a lock or allocating. Old versions are recycled once no reader that could
+// still see them remains pinned (epoch based reclamation).
+class ObjectList {
+public:
+    struct Version {
+        std::vector<GameObject*> objects;
+    };
+
+    // Pinned, immutable view of one published version. Keep it short lived: the writer
+    // waits for pinned readers before destroying removed objects.
+    class View {
+    public:
+        explicit View(const ObjectList& list);
+        ~View();
+
+        View(const View&) = delete;
+        View& operator=(const View&) = delete;
+
+        std::vector<GameObject*>::const_iterator begin() const { return version->objects.begin(); }
+        std::vector<GameObject*>::const_iterator end() const { return version->objects.end(); }
+        size_t size() const { return version->objects.size(); }
+        GameObject* operator[](size_t i) const { return version->objects[i]; }
+
+    private:
+        const Version* version;
+    };
+
+    ObjectList();
+    ~ObjectList();
+
+    ObjectList(const ObjectList&) = delete;
+    ObjectList& operator=(const ObjectList&) = delete;
+
+    View read() const { return View(*this); }
+
+    // Writer side. Calls must be serialized by the caller.
+    // Copies objects into a recycled version and makes it current.
+    void publish(const std::vector<GameObject*>& objects);
+
+    // Blocks until every reader pinned before the last publish has let go, after which
+    // objects missing from the current version can be destroyed safely.
+    // Must not be called while the calling thread holds a View.
+    static void synchronize();
+
+private:
+    static constexpr size_t MAX_READERS = 64;
+    static constexpr uint64_t IDLE = 0;   // Epochs start at 1
+
+    // Epoch each thread pinned at, IDLE when not reading. A slot is claimed by a thread on
+    // its first read and handed back when that thread exits, so the limit is on threads
+    // reading at the same time rather than threads ever created.
+    static std::atomic<uint64_t> readerEpochs[MAX_READERS];
+    static std::atomic<bool> readerClaimed[MAX_READERS];
+    static std::atomic<uint64_t> globalEpoch;
+
+    // Thread local owner of a reader slot, releases it on thread exit
+    struct ReaderSlot;
+
+    static void pin();
+    static void unpin();
+    static uint64_t oldestPinnedEpoch();
+
+    struct Retired {
+        Version* version;
+        uint64_t epoch;
+    };
+
+    void reclaim();
+
+    std::atomic<Version*> current;
+    std::vector<Retired> retired;
+    std::vector<Version*> spare;
+};
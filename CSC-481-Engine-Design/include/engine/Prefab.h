@@ -0,0 +1,86 @@
+#pragma once
+
+#include "ComponentStorage.h"
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// A preconfigured set of components that Engine::instantiate copies into new objects.
+// Build it once at load time with add<T>(args...), then spawn from it as often as needed;
+// each spawn copy constructs the components straight into their archetype columns.
+//
+// With recycling on, instances removed from the engine are parked instead of destroyed:
+// they keep their pool slot and component storage but drop out of the object list and
+// views, and the next spawn resets one in place from the prototypes.
+class Prefab {
+public:
+    explicit Prefab(std::string name) : name(std::move(name)) {}
+    ~Prefab() { clear(); }
+
+    Prefab(const Prefab&) = delete;
+    Prefab& operator=(const Prefab&) = delete;
+
+    const std::string& getName() const { return name; }
+
+    // Park up to maxParked removed instances for reuse. Turning it off keeps what is
+    // already parked until shutdown.
+    void setRecycling(bool enabled, size_t maxParked = 256);
+    bool isRecycling() const;
+    size_t getParkedCount() const;
+
+    // Set the prototype T every instance starts with, replacing any earlier one
+    template <typename T, typename... Args>
+    T& add(Args&&... args) {
+        static_assert(std::is_copy_constructible_v<T>, "prefab components are copied into every instance");
+        const ComponentTypeInfo& info = ComponentTypeInfo::get<T>();
+
+        void* data = ::operator new(sizeof(T), std::align_val_t(alignof(T)));
+        T* prototype = new (data) T(std::forward<Args>(args)...);
+        insert(&info, data);
+        return *prototype;
+    }
+
+    // Prototype of T, or nullptr if the prefab doesn't have one
+    template <typename T>
+    T* get() const {
+        uint32_t id = ComponentTypeId<T>::get();
+        for (const Entry& entry : entries) {
+            if (entry.type->id == id) return static_cast<T*>(entry.data);
+        }
+        return nullptr;
+    }
+
+private:
+    struct Entry {
+        const ComponentTypeInfo* type;
+        void* data;
+    };
+
+    void insert(const ComponentTypeInfo* type, void* data);
+    void clear();
+
+    // Called by the engine once no reader can still see obj. park() returns false when
+    // recycling is off or the parking lot is full; the caller destroys obj then.
+    bool park(GameObject* obj);
+    GameObject* unpark();
+    std::vector<GameObject*> takeParked();
+
+    std::string name;
+    std::vector<Entry> entries;   // sorted by type id, the same order as the archetype's columns
+
+    // Set by ComponentStorage::instantiate under its lock, reset whenever entries change
+    mutable Archetype* archetype = nullptr;
+
+    // Spawns and removals can come from worker threads
+    mutable std::mutex parkMutex;
+    std::vector<GameObject*> parked;
+    bool recycling = false;
+    size_t maxParked = 0;
+
+    friend class ComponentStorage;
+    friend class Engine;
+};
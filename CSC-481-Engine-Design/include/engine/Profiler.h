@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Scoped-zone frame profiler. Each thread records finished zones into its own ring buffer
+// with nanosecond timestamps; writeChromeTrace() dumps whatever the buffers still hold as
+// Chrome trace_event JSON (open in chrome://tracing or ui.perfetto.dev).
+//
+// Instrument code with ENGINE_PROFILE_SCOPE, which compiles to nothing unless
+// ENGINE_ENABLE_PROFILER is defined (the ENGINE_ENABLE_PROFILER CMake option).
+class Profiler {
+public:
+    // Zones kept per thread before the oldest are overwritten
+    static constexpr uint32_t RING_CAPACITY = 1 << 16;
+
+    // Monotonic clock in nanoseconds
+    static uint64_t now();
+
+    // name must stay valid until the trace is written: a literal or an intern()ed string
+    static void record(const char* name, uint64_t startNs, uint64_t endNs);
+
+    // Stable copy of a runtime string, for zones named after event types and the like
+    static const char* intern(const std::string& name);
+
+    // Write every buffered zone from every thread. Safe while other threads keep recording;
+    // zones overwritten during the dump are left out. Returns false if the file can't be opened.
+    static bool writeChromeTrace(const char* path);
+};
+
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) : name(name), start(Profiler::now()) {}
+    ~ProfileScope() { Profiler::record(name, start, Profiler::now()); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    uint64_t start;
+};
+
+#define ENGINE_PROFILE_CONCAT_INNER(a, b) a##b
+#define ENGINE_PROFILE_CONCAT(a, b) ENGINE_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef ENGINE_ENABLE_PROFILER
+#define ENGINE_PROFILE_SCOPE(name) ProfileScope ENGINE_PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#define ENGINE_PROFILE_SCOPE_DYNAMIC(name) ProfileScope ENGINE_PROFILE_CONCAT(profileScope_, __LINE__)(Profiler::intern(name))
+#else
+#define ENGINE_PROFILE_SCOPE(name) ((void)0)
+#define ENGINE_PROFILE_SCOPE_DYNAMIC(name) ((void)0)
+#endif
@@ -1,20 +1,35 @@
 #pragma once
 
 #include "Component.h"
+#include "SpriteBatch.h"
 #include "TransformComponent.h"
 #include <SDL3/SDL.h>
+#include <memory>
 #include <string>
 
 class RenderComponent : public Component {
 public:
     RenderComponent(const std::string& texturePath, bool tile = false);
-    ~RenderComponent();
 
     void draw(GameObject& obj, SDL_Renderer* renderer) override;
     
     void draw(GameObject& obj, SDL_Renderer* renderer, const Vec2& cameraOffset);
 
+    // Queue into a batch instead of drawing now, same placement and tiling as draw(). view is
+    // the visible area in world coordinates (see Engine::getViewRect): quads outside it are
+    // skipped, tiled objects only emit their visible tiles, and the rest are drawn relative
+    // to its top-left corner.
+    void draw(GameObject& obj, SpriteBatch& batch, const SDL_FRect& view);
+
 private:
-    SDL_Texture* texture = nullptr;
+    // Call fn(const SDL_FRect&) with the screen rectangle of each quad this component draws,
+    // relative to view's corner. With cull set, only quads overlapping view are passed on.
+    template <typename Fn>
+    void forEachQuad(GameObject& obj, const SDL_FRect& view, bool cull, Fn&& fn);
+
+    // Shared through the TextureCache, every component using an image draws the same texture.
+    // source is the image's part of it, a sub-rectangle when the image lives in an atlas.
+    std::shared_ptr<SDL_Texture> texture;
+    SDL_FRect source{ 0.0f, 0.0f, 0.0f, 0.0f };
     bool tileTexture = false;
 };
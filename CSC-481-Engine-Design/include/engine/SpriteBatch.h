@@ -0,0 +1,42 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <cstddef>
+#include <vector>
+
+// Collects textured quads for a frame and submits each run of consecutive quads sharing a
+// texture with one SDL_RenderGeometry call. Quads are drawn in the order they were queued,
+// so overlapping sprites layer the same as with one draw call each; the draw call count
+// follows the number of texture changes, which an atlas keeps low.
+class SpriteBatch {
+public:
+    // Queue texture stretched over dst. src picks a sub-rectangle in texels, nullptr for
+    // the whole texture.
+    void draw(SDL_Texture* texture, const SDL_FRect& dst, const SDL_FRect* src = nullptr,
+              SDL_FColor color = SDL_FColor{ 1.0f, 1.0f, 1.0f, 1.0f });
+
+    // Submit everything queued since the last flush and start over
+    void flush(SDL_Renderer* renderer);
+
+    size_t getQueuedCount() const { return sprites.size(); }
+
+    // Sprites and SDL_RenderGeometry calls in the last flush
+    size_t getLastSpriteCount() const { return lastSpriteCount; }
+    size_t getLastDrawCalls() const { return lastDrawCalls; }
+
+private:
+    struct Sprite {
+        SDL_Texture* texture;
+        SDL_FRect dst;
+        SDL_FRect uv;   // normalized texture coordinates
+        SDL_FColor color;
+    };
+
+    // Kept between frames to reuse their storage
+    std::vector<Sprite> sprites;
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;   // two triangles per quad, relative to the group's first vertex
+
+    size_t lastSpriteCount = 0;
+    size_t lastDrawCalls = 0;
+};
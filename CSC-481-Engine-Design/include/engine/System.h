@@ -0,0 +1,46 @@
+#pragma once
+
+#include "ComponentTypeId.h"
+
+// Per-frame work over a set of component types. A system declares which types it reads
+// and writes so the SystemScheduler can run systems that don't conflict in parallel.
+class System {
+public:
+    explicit System(const char* name) : name(name) {}
+    virtual ~System() = default;
+
+    virtual void update(float deltaTime) = 0;
+
+    const char* getName() const { return name; }
+    ComponentMask getReads() const { return readMask; }
+    ComponentMask getWrites() const { return writeMask; }
+    ComponentMask getReplaced() const { return replacedMask; }
+    bool isStructural() const { return structural; }
+
+    // True if the two systems must not run at the same time
+    bool conflictsWith(const System& other) const {
+        if (structural || other.structural) return true;
+        return (writeMask & (other.readMask | other.writeMask)) != 0 || (other.writeMask & readMask) != 0;
+    }
+
+protected:
+    template <typename... Ts>
+    void reads() { readMask |= (ComponentTypeId<Ts>::mask() | ...); }
+
+    template <typename... Ts>
+    void writes() { writeMask |= (ComponentTypeId<Ts>::mask() | ...); }
+
+    // This system drives Ts itself, so GameObject::update skips their Component::update
+    template <typename... Ts>
+    void replaces() { replacedMask |= (ComponentTypeId<Ts>::mask() | ...); }
+
+    // Creates or destroys objects or changes component sets. Runs with no other system alongside.
+    void setStructural() { structural = true; }
+
+private:
+    const char* name;
+    ComponentMask readMask = 0;
+    ComponentMask writeMask = 0;
+    ComponentMask replacedMask = 0;
+    bool structural = false;
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "System.h"
+#include "JobSystem.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// Runs registered systems once per frame. Systems are ordered by registration; a later
+// system depends on every earlier one it conflicts with, and the resulting DAG is executed
+// on the JobSystem so independent systems run in parallel.
+class SystemScheduler {
+public:
+    static System* add(std::unique_ptr<System> system);
+    static void clear();
+
+    // Run every system and return once all have finished
+    static void run(float deltaTime);
+
+    // Union of every system's replaced component types, read lock free by GameObject::update
+    static ComponentMask getReplacedMask() { return s_replacedMask.load(std::memory_order_acquire); }
+
+private:
+    struct Node {
+        System* system = nullptr;
+        std::vector<size_t> successors;
+        int dependencies = 0;
+        std::atomic<int> remaining{ 0 };
+    };
+
+    static void build();
+    static void runNode(void* context);
+
+    static std::vector<std::unique_ptr<System>> s_systems;
+    static std::vector<std::unique_ptr<Node>> s_nodes;
+    static bool s_dirty;
+    static std::atomic<ComponentMask> s_replacedMask;
+
+    // Current frame, only valid inside run()
+    static float s_deltaTime;
+    static JobSystem::Counter s_pending;
+};
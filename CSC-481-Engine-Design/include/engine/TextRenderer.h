@@ -0,0 +1,29 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+
+// HUD text without rasterizing and uploading every label every frame. Each font gets a
+// glyph atlas built on first use (printable ASCII, rendered white), and strings are drawn
+// as one quad per glyph through Engine::getSpriteBatch(), tinted by vertex color. A label
+// drawn unchanged at the same position for a while is promoted to a texture of its own, so
+// a stable label costs one quad and gets the font's full kerning. Text that keeps changing
+// stays on the atlas and never enters the cache, so it doesn't allocate per frame.
+//
+// Text is queued, not drawn immediately: it appears when the batch is flushed, which for
+// the HUD is after the render callback, on top of everything else.
+class TextRenderer {
+public:
+    // Queue text with its top left corner at x, y. Does nothing when headless.
+    static void draw(TTF_Font* font, const char* text, SDL_Color color, float x, float y);
+
+    // Advance the frame counter the string cache ages entries by. Called by Engine::run.
+    static void nextFrame();
+
+    // Forget everything cached for font, call before closing it
+    static void releaseFont(TTF_Font* font);
+
+    // Drop every atlas and cached string. Engine::shutdown calls this before the
+    // renderer is destroyed.
+    static void clear();
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Packs many small images into a few shared atlas textures at load time, so a batch of
+// sprites using any of them needs one texture instead of one per image. Packed paths are
+// registered with TextureCache::getRegion, so RenderComponents created afterwards draw
+// from the atlas without knowing about it.
+class TextureAtlas {
+public:
+    // Shelf-pack paths into square pages of at most pageSize texels, padding texels apart so
+    // filtering doesn't bleed neighbours in. Images that don't load or don't fit a page stay
+    // standalone. Call after Engine::init. Returns the number of pages created.
+    static int build(const std::vector<std::string>& paths, int pageSize = 1024, int padding = 2);
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+// A texture plus the texels an image occupies in it: the whole texture for a standalone
+// image, a sub-rectangle for one packed into a TextureAtlas page
+struct TextureRegion {
+    std::shared_ptr<SDL_Texture> texture;
+    SDL_FRect source{ 0.0f, 0.0f, 0.0f, 0.0f };
+};
+
+// Textures loaded from image files, keyed by path. Each file is decoded and uploaded once;
+// every RenderComponent drawing it shares the same handle. The cache holds a reference of
+// its own, so a texture stays loaded until it is evicted and its last user lets go.
+//
+// Lookups of loaded textures work from any thread. Loading, evicting and clearing create or
+// destroy SDL textures, so they are main thread only.
+class TextureCache {
+public:
+    using Handle = std::shared_ptr<SDL_Texture>;
+
+    // Texture for path, loading it on first use. nullptr when headless or the load fails;
+    // failures are remembered so a missing file isn't retried on every spawn. A first use
+    // off the main thread asserts, and returns nullptr without loading in release builds.
+    static Handle get(const std::string& path);
+
+    // Where path's image is drawn from: its atlas region if it was packed, otherwise the
+    // whole standalone texture from get()
+    static TextureRegion getRegion(const std::string& path);
+
+    // Point path at a region of an atlas page. Called by TextureAtlas::build.
+    static void addRegion(const std::string& path, Handle page, const SDL_FRect& source);
+
+    // Load ahead of time, during setup, so the first spawn doesn't stall on disk
+    static bool preload(const std::string& path);
+
+    // Drop the cache's reference, standalone and atlas region alike. Objects still drawing
+    // the texture keep it alive.
+    static void evict(const std::string& path);
+
+    // Evict every standalone texture no RenderComponent uses anymore, returns how many were
+    // dropped. Atlas regions share their page and are only dropped by evict() or clear().
+    static size_t evictUnused();
+
+    // Drop every reference the cache holds. Engine::shutdown calls this before the
+    // renderer is destroyed.
+    static void clear();
+
+    static size_t getCount();
+};
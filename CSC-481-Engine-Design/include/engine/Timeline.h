@@ -10,6 +10,9 @@ public:
     // Update internal time and return scaled deltaTime
     double update();
 
+    // Advance by a given delta (e.g. the engine's fixed step) instead of wall time
+    double advance(double delta);
+
     // Set the speed scale, clamped between minSpeed and maxSpeed
     void setScale(double s);
     double getScale() const;
@@ -10,13 +10,20 @@ struct Vec2 {
 class TransformComponent : public Component {
 public:
     TransformComponent(float x = 0.f, float y = 0.f, float w = 32.f, float h = 32.f, float vx = 0.f, float vy = 0.f)
-        : position({ x, y }), size({ w, h }), velocity({ vx, vy }) {
+        : position({ x, y }), previousPosition({ x, y }), size({ w, h }), velocity({ vx, vy }) {
     }
 
     // Position accessors
     Vec2 getPosition() const { return position; }
     void setPosition(float x, float y) { position = { x, y }; }
 
+    // Position at the start of the current fixed step, for render interpolation
+    void storePreviousPosition() { previousPosition = position; }
+    Vec2 getInterpolatedPosition(float alpha) const {
+        return { previousPosition.x + (position.x - previousPosition.x) * alpha,
+                 previousPosition.y + (position.y - previousPosition.y) * alpha };
+    }
+
     // Size accessors
     Vec2 getSize() const { return size; }
     void setSize(float w, float h) { size = { w, h }; }
@@ -36,6 +43,7 @@ public:
 
 private:
     Vec2 position;   // world position
+    Vec2 previousPosition;
     Vec2 size;       // dimensions
     Vec2 velocity;   // movement velocity
 };
@@ -1,10 +1,22 @@
 #include <engine/Client.h>
 #include <sstream>
 #include <iostream>
+#include <cstdarg>
+#include <cstdio>
 
 // static member init
 int Client::clientID = 0;
 
+// printf-style append, formats on the stack so the reused buffer is the only storage
+static void appendFormat(std::string& out, const char* format, ...) {
+	char field[128];
+	va_list args;
+	va_start(args, format);
+	int length = std::vsnprintf(field, sizeof(field), format, args);
+	va_end(args);
+	if (length > 0) out.append(field, length < static_cast<int>(sizeof(field)) ? length : sizeof(field) - 1);
+}
+
 Client::Client()
     : context(1),
     requester(context, zmq::socket_type::req),
@@ -69,32 +81,38 @@ void Client::sendCommand(const ClientCommand& cmd) {
 		}
 	}
 
-	std::ostringstream oss;
-	oss << "CMD " << cmd.clientId << " " << cmd.tick << " " << cmd.actions
-		<< " " << cmd.x << " " << cmd.y << " " << cmd.events.size() << "\n";
+	// Built in a buffer kept across sends, so steady state serialization doesn't allocate.
+	// %g matches the stream formatting the server parses.
+	std::string& msg = sendBuffer;
+	msg.clear();
+	appendFormat(msg, "CMD %d %d %u %g %g %zu\n",
+		cmd.clientId, cmd.tick, cmd.actions, cmd.x, cmd.y, cmd.events.size());
 
 	// Serialize each Event line-by-line
 	for (const auto& e : cmd.events) {
-		oss << e.type << " " << e.priority << " " << e.parameters.size();
+		msg += e.type;
+		appendFormat(msg, " %d %zu", e.priority, e.parameters.size());
 		for (const auto& [key, val] : e.parameters) {
-			oss << " " << key << " ";
+			msg += ' ';
+			msg += key;
 			switch (val.type) {
 			case Variant::Type::INT:
-				oss << "INT " << val.asInt;
+				appendFormat(msg, " INT %d", val.asInt);
 				break;
 			case Variant::Type::FLOAT:
-				oss << "FLOAT " << val.asFloat;
+				appendFormat(msg, " FLOAT %g", val.asFloat);
+				break;
+			case Variant::Type::ENTITY:
+				appendFormat(msg, " ENTITY %llu", static_cast<unsigned long long>(val.asEntity.pack()));
 				break;
 			default:
-				oss << "UNSUPPORTED 0";
+				msg += " UNSUPPORTED 0";
 				break;
 			}
 		}
-		oss << "\n";
+		msg += '\n';
 	}
 
-	std::string msg = oss.str();
-
 	zmq::message_t request(msg.size());
 	memcpy(request.data(), msg.data(), msg.size());
 	requester.send(request, zmq::send_flags::none);
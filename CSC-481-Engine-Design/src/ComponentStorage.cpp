@@ -0,0 +1,306 @@
+#include <engine/ComponentStorage.h>
+#include <engine/Prefab.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+Archetype::Archetype(std::vector<const ComponentTypeInfo*> types)
+    : types(std::move(types)),
+      chunks(new std::atomic<char*>[MAX_CHUNKS])
+{
+    columnOf.fill(-1);
+    for (size_t column = 0; column < this->types.size(); column++) {
+        columnOf[this->types[column]->id] = static_cast<int8_t>(column);
+        mask |= ComponentMask(1) << this->types[column]->id;
+    }
+
+    // Owner pointers and active flags come first, then one column per component type
+    size_t offset = ACTIVE_OFFSET + CHUNK_CAPACITY * sizeof(std::atomic<uint8_t>);
+    for (const ComponentTypeInfo* info : this->types) {
+        offset = (offset + info->align - 1) / info->align * info->align;
+        columnOffsets.push_back(offset);
+        offset += CHUNK_CAPACITY * info->size;
+        chunkAlign = std::max(chunkAlign, info->align);
+    }
+    chunkBytes = offset;
+
+    for (uint32_t i = 0; i < MAX_CHUNKS; i++) {
+        chunks[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+Archetype::~Archetype() {
+    uint32_t count = chunkCount.load();
+    for (uint32_t chunk = 0; chunk < count; chunk++) {
+        for (uint32_t row = 0; row < CHUNK_CAPACITY; row++) {
+            if (getOwners(chunk)[row]) {
+                freeSlot(chunk * CHUNK_CAPACITY + row);
+            }
+        }
+        ::operator delete(chunks[chunk].load(), std::align_val_t(chunkAlign));
+    }
+}
+
+void Archetype::addChunk() {
+    uint32_t index = chunkCount.load();
+    if (index >= MAX_CHUNKS) {
+        std::cerr << "[ComponentStorage] Archetype chunk table is full!" << std::endl;
+        std::abort();
+    }
+
+    char* chunk = static_cast<char*>(::operator new(chunkBytes, std::align_val_t(chunkAlign)));
+    std::fill_n(reinterpret_cast<GameObject**>(chunk), CHUNK_CAPACITY, nullptr);
+    for (uint32_t row = 0; row < CHUNK_CAPACITY; row++) {
+        new (chunk + ACTIVE_OFFSET + row * sizeof(std::atomic<uint8_t>)) std::atomic<uint8_t>(0);
+    }
+    chunks[index].store(chunk, std::memory_order_release);
+    chunkCount.store(index + 1, std::memory_order_release);
+
+    // Hand out low slots first so iteration stays near the front of the chunk
+    for (uint32_t row = CHUNK_CAPACITY; row > 0; row--) {
+        freeSlots.push_back(index * CHUNK_CAPACITY + row - 1);
+    }
+}
+
+uint32_t Archetype::allocateSlot(GameObject* owner) {
+    if (freeSlots.empty()) addChunk();
+
+    uint32_t slot = freeSlots.back();
+    freeSlots.pop_back();
+
+    GameObject** owners = reinterpret_cast<GameObject**>(chunks[slot / CHUNK_CAPACITY].load());
+    owners[slot % CHUNK_CAPACITY] = owner;
+    setActive(slot, true);
+    liveCount++;
+    return slot;
+}
+
+void Archetype::freeSlot(uint32_t slot) {
+    GameObject** owners = reinterpret_cast<GameObject**>(chunks[slot / CHUNK_CAPACITY].load());
+    if (!owners[slot % CHUNK_CAPACITY]) return;
+
+    for (size_t column = 0; column < types.size(); column++) {
+        types[column]->destroy(getData(static_cast<int>(column), slot));
+    }
+
+    owners[slot % CHUNK_CAPACITY] = nullptr;
+    freeSlots.push_back(slot);
+    liveCount--;
+}
+
+// Both are intentionally leaked so objects destroyed during static teardown can still release their components
+std::recursive_mutex& ComponentStorage::getMutex() {
+    static auto* mutex = new std::recursive_mutex();
+    return *mutex;
+}
+
+namespace {
+    std::atomic<bool> sharedReads{ false };
+}
+
+void ComponentStorage::setSharedReads(bool shared) {
+    sharedReads.store(shared, std::memory_order_release);
+}
+
+bool ComponentStorage::hasSharedReads() {
+    return sharedReads.load(std::memory_order_acquire);
+}
+
+std::vector<std::unique_ptr<Archetype>>& ComponentStorage::getArchetypes() {
+    static auto* archetypes = new std::vector<std::unique_ptr<Archetype>>();
+    return *archetypes;
+}
+
+std::vector<std::unique_ptr<ComponentStorage::Query>>& ComponentStorage::getQueries() {
+    static auto* queries = new std::vector<std::unique_ptr<Query>>();
+    return *queries;
+}
+
+const std::vector<Archetype*>& ComponentStorage::getMatchingArchetypes(ComponentMask mask) {
+    std::lock_guard<std::recursive_mutex> lock(getMutex());
+
+    auto& queries = getQueries();
+    for (auto& query : queries) {
+        if (query->mask == mask) return query->archetypes;
+    }
+
+    // First time this component set is queried, scan once and keep the result
+    auto query = std::make_unique<Query>();
+    query->mask = mask;
+    for (auto& archetype : getArchetypes()) {
+        if ((archetype->getMask() & mask) == mask) query->archetypes.push_back(archetype.get());
+    }
+    queries.push_back(std::move(query));
+    return queries.back()->archetypes;
+}
+
+void ComponentStorage::getTypeUsage(std::array<ComponentTypeUsage, MAX_COMPONENT_TYPES>& usage) {
+    std::lock_guard<std::recursive_mutex> lock(getMutex());
+
+    usage.fill(ComponentTypeUsage{});
+    for (auto& archetype : getArchetypes()) {
+        size_t reserved = static_cast<size_t>(archetype->getChunkCount()) * Archetype::CHUNK_CAPACITY;
+        for (const ComponentTypeInfo* type : archetype->getTypes()) {
+            ComponentTypeUsage& entry = usage[type->id];
+            entry.type = type;
+            entry.liveCount += archetype->getLiveCount();
+            entry.reservedCount += reserved;
+        }
+    }
+}
+
+void ComponentStorage::instantiate(GameObject* owner, EntityRecord& record, const Prefab& prefab) {
+    ScopedLatency timing(MemoryStats::getComponentAllocLatency());
+    std::lock_guard<std::recursive_mutex> lock(getMutex());
+    if (prefab.entries.empty()) {
+        destroy(record);
+        return;
+    }
+
+    if (!prefab.archetype) {
+        std::vector<const ComponentTypeInfo*> types;
+        for (const Prefab::Entry& entry : prefab.entries) types.push_back(entry.type);
+        prefab.archetype = findOrCreateArchetype(std::move(types));
+    }
+
+    Archetype* target = prefab.archetype;
+    uint32_t slot;
+    if (record.archetype == target) {
+        // Same component set: overwrite the old components where they sit
+        slot = record.slot;
+        for (size_t column = 0; column < target->getColumnCount(); column++) {
+            target->getTypes()[column]->destroy(target->getData(static_cast<int>(column), slot));
+        }
+    }
+    else {
+        destroy(record);
+        slot = target->allocateSlot(owner);
+    }
+
+    // Entries are sorted by type id like the columns, so they line up one to one
+    for (size_t column = 0; column < prefab.entries.size(); column++) {
+        const Prefab::Entry& entry = prefab.entries[column];
+        void* data = target->getData(static_cast<int>(column), slot);
+        entry.type->copyConstruct(data, entry.data);
+        record.components[entry.type->id] = entry.type->asComponent(data);
+    }
+
+    record.archetype = target;
+    record.slot = slot;
+    target->setActive(slot, true);
+}
+
+void ComponentStorage::setActive(EntityRecord& record, bool active) {
+    std::lock_guard<std::recursive_mutex> lock(getMutex());
+    if (record.archetype) record.archetype->setActive(record.slot, active);
+}
+
+void ComponentStorage::destroy(EntityRecord& record) {
+    std::lock_guard<std::recursive_mutex> lock(getMutex());
+    if (!record.archetype) return;
+
+    record.archetype->freeSlot(record.slot);
+    record.archetype = nullptr;
+    record.slot = 0;
+    record.components.fill(nullptr);
+}
+
+Archetype* ComponentStorage::findArchetypeWith(Archetype* base, const ComponentTypeInfo* added) {
+    std::vector<const ComponentTypeInfo*> types;
+    if (base) types = base->getTypes();
+    types.push_back(added);
+    return findOrCreateArchetype(std::move(types));
+}
+
+Archetype* ComponentStorage::findArchetypeWithout(Archetype* base, uint32_t removedId) {
+    std::vector<const ComponentTypeInfo*> types = base->getTypes();
+    types.erase(std::remove_if(types.begin(), types.end(),
+        [&](const ComponentTypeInfo* info) { return info->id == removedId; }),
+        types.end());
+    return findOrCreateArchetype(std::move(types));
+}
+
+Archetype* ComponentStorage::findOrCreateArchetype(std::vector<const ComponentTypeInfo*> types) {
+    std::sort(types.begin(), types.end(),
+        [](const ComponentTypeInfo* a, const ComponentTypeInfo* b) { return a->id < b->id; });
+
+    auto& archetypes = getArchetypes();
+    for (auto& archetype : archetypes) {
+        if (archetype->getTypes() == types) return archetype.get();
+    }
+
+    archetypes.push_back(std::make_unique<Archetype>(std::move(types)));
+    Archetype* created = archetypes.back().get();
+
+    // Extend cached queries instead of invalidating them
+    for (auto& query : getQueries()) {
+        if ((created->getMask() & query->mask) == query->mask) query->archetypes.push_back(created);
+    }
+    return created;
+}
+
+void ComponentStorage::migrate(GameObject* owner, EntityRecord& record, Archetype* target) {
+    uint32_t newSlot = target->allocateSlot(owner);
+
+    if (record.archetype) {
+        Archetype* source = record.archetype;
+        const auto& sourceTypes = source->getTypes();
+
+        for (size_t column = 0; column < sourceTypes.size(); column++) {
+            int targetColumn = target->findColumn(sourceTypes[column]->id);
+            if (targetColumn < 0) continue;
+            sourceTypes[column]->moveConstruct(
+                target->getData(targetColumn, newSlot),
+                source->getData(static_cast<int>(column), record.slot));
+        }
+
+        // Destroys the moved-from husks along with anything the target doesn't keep
+        source->freeSlot(record.slot);
+    }
+
+    record.archetype = target;
+    record.slot = newSlot;
+
+    // Rebuild the slot table, columns the target dropped go back to null
+    record.components.fill(nullptr);
+    for (size_t column = 0; column < target->getColumnCount(); column++) {
+        record.components[target->getTypes()[column]->id] = target->getComponent(static_cast<int>(column), newSlot);
+    }
+}
+
+uint32_t ComponentTypeRegistry::next() {
+    static std::atomic<uint32_t> counter{ 0 };
+    uint32_t id = counter.fetch_add(1);
+    if (id >= MAX_COMPONENT_TYPES) {
+        std::cerr << "[ComponentStorage] More than " << MAX_COMPONENT_TYPES << " component types registered!" << std::endl;
+        std::abort();
+    }
+    return id;
+}
+
+std::string ComponentTypeRegistry::parseTypeName(const char* signature) {
+    std::string sig(signature);
+    std::string name;
+
+    // GCC: "... [with T = Foo]", Clang: "... [T = Foo]"
+    size_t start = sig.find("T = ");
+    if (start != std::string::npos) {
+        start += 4;
+        size_t end = sig.find_first_of(";]", start);
+        name = sig.substr(start, end - start);
+    }
+    // MSVC: "... componentTypeName<class Foo>(void)"
+    else if ((start = sig.find("componentTypeName<")) != std::string::npos) {
+        start += 18;
+        size_t end = sig.rfind(">(");
+        name = sig.substr(start, end - start);
+        for (const char* prefix : { "class ", "struct " }) {
+            if (name.compare(0, strlen(prefix), prefix) == 0) name.erase(0, strlen(prefix));
+        }
+    }
+    else {
+        name = sig;
+    }
+    return name;
+}
@@ -2,64 +2,199 @@
 #include <engine/Input.h>
 #include <engine/RenderComponent.h>
 #include <engine/GameObjectAllocator.hpp>
+#include <engine/CoreSystems.h>
+#include <engine/TextureCache.h>
+#include <engine/TextRenderer.h>
 #include <SDL3/SDL.h>
 #include <iostream>
-#include <algorithm>
-#include <unordered_set>
+#include <cmath>
 
 SDL_Window* Engine::s_window = nullptr;
 SDL_Renderer* Engine::s_renderer = nullptr;
+SpriteBatch Engine::s_spriteBatch;
 bool Engine::s_running = false;
 
+double Engine::s_fixedStep = 0.0;
+int Engine::s_maxCatchUpSteps = 5;
+float Engine::s_interpolationAlpha = 1.0f;
+float Engine::s_targetFps = 0.0f;
+uint64_t Engine::s_missedFrames = 0;
+bool Engine::s_headless = false;
+std::thread::id Engine::s_mainThread;
+int Engine::s_maxFrames = 0;
+std::unique_ptr<FrameArena> Engine::s_frameArena;
+const char* Engine::s_memoryReportPath = nullptr;
+std::unordered_map<std::string, std::unique_ptr<Prefab>> Engine::s_prefabs;
+std::mutex Engine::s_prefabsMutex;
+
 std::vector<GameObject*> Engine::s_gameObjects;
 std::mutex Engine::s_gameObjectsMutex;
 
-std::thread Engine::s_updateThread;
-std::atomic<bool> Engine::s_workerRunning = false;
-
-std::vector<GameObject*> Engine::s_pendingRemovals;
+std::vector<EntityHandle> Engine::s_pendingRemovals;
+std::vector<Engine::ObjectSlot> Engine::s_objectSlots;
+ObjectList Engine::s_publishedObjects;
+bool Engine::s_objectsDirty = false;
 
 bool Engine::init(const Config& cfg) {
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS) < 0) {
+    s_mainThread = std::this_thread::get_id();
+    s_headless = cfg.headless;
+    s_maxFrames = cfg.maxFrames;
+    s_frameArena = std::make_unique<FrameArena>(cfg.frameArenaBytes);
+    s_memoryReportPath = cfg.memoryReportPath;
+    MemoryStats::setLatencySampling(cfg.sampleAllocLatency);
+
+    // Headless runs skip the video subsystem entirely, so no display is needed
+    SDL_InitFlags flags = s_headless ? SDL_INIT_EVENTS : (SDL_INIT_VIDEO | SDL_INIT_EVENTS);
+    if (SDL_Init(flags) < 0) {
         SDL_Log("Couldn't initialize SDL: %s", SDL_GetError());
         return false;
     }
 
-    s_window = SDL_CreateWindow(cfg.title, cfg.width, cfg.height, SDL_WINDOW_RESIZABLE);
-    if (!s_window) {
-        SDL_Log("Couldn't create window: %s", SDL_GetError());
-        return false;
-    }
+    if (!s_headless) {
+        s_window = SDL_CreateWindow(cfg.title, cfg.width, cfg.height, SDL_WINDOW_RESIZABLE);
+        if (!s_window) {
+            SDL_Log("Couldn't create window: %s", SDL_GetError());
+            return false;
+        }
 
-    s_renderer = SDL_CreateRenderer(s_window, nullptr);
-    if (!s_renderer) {
-        SDL_Log("Couldn't create renderer: %s", SDL_GetError());
-        return false;
+        s_renderer = SDL_CreateRenderer(s_window, nullptr);
+        if (!s_renderer) {
+            SDL_Log("Couldn't create renderer: %s", SDL_GetError());
+            return false;
+        }
     }
 
+    JobSystem::init(cfg.workerThreads);
+
+    s_fixedStep = cfg.fixedStepHz > 0.0f ? 1.0 / cfg.fixedStepHz : 0.0;
+    s_maxCatchUpSteps = cfg.maxCatchUpSteps > 0 ? cfg.maxCatchUpSteps : 1;
+    s_targetFps = cfg.targetFps;
+
+    SystemScheduler::add(std::make_unique<GravitySystem>());
+    SystemScheduler::add(std::make_unique<MovementSystem>());
+    SystemScheduler::add(std::make_unique<ComponentUpdateSystem>());
+
     return true;
 }
 
 void Engine::shutdown() {
-    s_workerRunning = false;
-    if (s_updateThread.joinable()) s_updateThread.join();
+    SystemScheduler::clear();
+    JobSystem::shutdown();
 
+    // Destroy outside the list lock, destroying takes the storage lock and
+    // spawns take the two in the other order
+    std::vector<GameObject*> doomed;
     {
         std::lock_guard<std::mutex> lock(s_gameObjectsMutex);
-        for (GameObject* obj : s_gameObjects) {
+        doomed.swap(s_gameObjects);
+        s_objectSlots.clear();
+        s_pendingRemovals.clear();
+        s_objectsDirty = true;
+        publishGameObjects();
+    }
+    for (GameObject* obj : doomed) {
+        GameObjectAllocator::destroy(obj);
+    }
+
+    // Prototypes can hold textures, release them while the renderer still exists
+    for (auto& [name, prefab] : s_prefabs) {
+        for (GameObject* obj : prefab->takeParked()) {
             GameObjectAllocator::destroy(obj);
         }
-        s_gameObjects.clear();
     }
+    s_prefabs.clear();
+    TextureCache::clear();
+    TextRenderer::clear();
 
-    SDL_DestroyRenderer(s_renderer);
-    SDL_DestroyWindow(s_window);
+    if (s_memoryReportPath && !MemoryStats::writeReport(s_memoryReportPath)) {
+        SDL_Log("[Engine] Couldn't write memory report to %s", s_memoryReportPath);
+    }
+
+    if (s_renderer) SDL_DestroyRenderer(s_renderer);
+    if (s_window) SDL_DestroyWindow(s_window);
+    s_renderer = nullptr;
+    s_window = nullptr;
     SDL_Quit();
 }
 
-void Engine::addGameObject(GameObject* obj) {
+EntityHandle Engine::addGameObject(GameObject* obj) {
     std::lock_guard<std::mutex> lock(s_gameObjectsMutex);
+    EntityHandle handle = obj->getHandle();
+
+    if (handle.index >= s_objectSlots.size()) s_objectSlots.resize(handle.index + 1);
+    ObjectSlot& slot = s_objectSlots[handle.index];
+    if (slot.denseIndex != NOT_OWNED) return handle; // Already added
+
+    slot.denseIndex = static_cast<uint32_t>(s_gameObjects.size());
     s_gameObjects.push_back(obj);
+    s_objectsDirty = true;
+    return handle;
+}
+
+Engine::ObjectSlot* Engine::findSlot(GameObject* obj) {
+    uint32_t index = obj->getHandle().index;
+    if (index >= s_objectSlots.size() || s_objectSlots[index].denseIndex == NOT_OWNED) return nullptr;
+    return &s_objectSlots[index];
+}
+
+void Engine::unlinkGameObject(GameObject* obj) {
+    ObjectSlot* slot = findSlot(obj);
+    if (!slot) return;
+
+    // Swap-and-pop: the last object takes the removed one's place
+    uint32_t index = slot->denseIndex;
+    GameObject* last = s_gameObjects.back();
+    s_gameObjects[index] = last;
+    s_objectSlots[last->getHandle().index].denseIndex = index;
+    s_gameObjects.pop_back();
+
+    slot->denseIndex = NOT_OWNED;
+    s_objectsDirty = true;
+}
+
+void Engine::publishGameObjects() {
+    if (!s_objectsDirty) return;
+    s_publishedObjects.publish(s_gameObjects);
+    s_objectsDirty = false;
+}
+
+void Engine::flushRemovals() {
+    std::vector<GameObject*> doomed;
+    {
+        std::lock_guard<std::mutex> lock(s_gameObjectsMutex);
+        if (s_pendingRemovals.empty()) return;
+
+        doomed.reserve(s_pendingRemovals.size());
+        for (EntityHandle handle : s_pendingRemovals) {
+            // Stale handles (already destroyed) resolve to nullptr
+            GameObject* obj = resolve(handle);
+            if (!obj || !findSlot(obj)) continue;
+
+            unlinkGameObject(obj);
+            doomed.push_back(obj);
+        }
+        s_pendingRemovals.clear();
+        publishGameObjects();
+    }
+
+    // Readers never take the mutex, so wait until none can still see the batch
+    ObjectList::synchronize();
+    for (GameObject* obj : doomed) {
+        retireGameObject(obj);
+    }
+}
+
+void Engine::retireGameObject(GameObject* obj) {
+    Prefab* prefab = obj->prefab;
+    if (!prefab || !prefab->park(obj)) {
+        GameObjectAllocator::destroy(obj);
+        return;
+    }
+
+    // Parked: invisible to views, and old handles stop resolving as if it had been destroyed
+    ComponentStorage::setActive(obj->record, false);
+    EntityRegistry::release(obj->handle);
+    obj->handle = EntityHandle{};
 }
 
 void Engine::usePoolAllocator(bool usePool, size_t poolCapacity) {
@@ -71,6 +206,46 @@ void Engine::usePoolAllocator(bool usePool, size_t poolCapacity) {
     }
 }
 
+Prefab& Engine::definePrefab(const std::string& name) {
+    std::lock_guard<std::mutex> lock(s_prefabsMutex);
+    std::unique_ptr<Prefab>& prefab = s_prefabs[name];
+    if (!prefab) prefab = std::make_unique<Prefab>(name);
+    return *prefab;
+}
+
+Prefab* Engine::getPrefab(const std::string& name) {
+    std::lock_guard<std::mutex> lock(s_prefabsMutex);
+    auto it = s_prefabs.find(name);
+    return it != s_prefabs.end() ? it->second.get() : nullptr;
+}
+
+GameObject* Engine::spawnPrefab(Prefab& prefab) {
+    GameObject* obj = prefab.unpark();
+    if (obj) {
+        // Back from the parking lot under a fresh handle, like a newly created object
+        obj->handle = EntityRegistry::create(obj);
+        obj->removalQueued.store(false, std::memory_order_release);
+        obj->paused = false;
+    }
+    else {
+        obj = GameObjectAllocator::create();
+        if (!obj) return nullptr;
+        obj->prefab = &prefab;
+    }
+
+    // A parked instance still sits in the prefab's archetype and is reset in its own slot
+    ComponentStorage::instantiate(obj, obj->record, prefab);
+
+    // Same owner hook emplaceComponent gives each component
+    if (Archetype* archetype = obj->record.archetype) {
+        for (size_t column = 0; column < archetype->getColumnCount(); column++) {
+            archetype->getComponent(static_cast<int>(column), obj->record.slot)->onAdd(*obj);
+            if (obj->record.archetype != archetype) break;
+        }
+    }
+    return obj;
+}
+
 GameObject* Engine::createGameObject() {
     GameObject* obj = GameObjectAllocator::create();
     if (obj) {
@@ -87,24 +262,46 @@ size_t Engine::getPoolCapacity() {
     return GameObjectAllocator::getPoolCapacity();
 }
 
-void Engine::removeGameObject(GameObject* obj) {
-    std::lock_guard<std::mutex> lock(s_gameObjectsMutex);
-    auto it = std::find(s_gameObjects.begin(), s_gameObjects.end(), obj);
-    if (it != s_gameObjects.end()) {
-        GameObjectAllocator::destroy(*it); // Uses proper allocator
-        s_gameObjects.erase(it);
+size_t Engine::getPoolHighWaterMark() {
+    return GameObjectAllocator::getPoolHighWaterMark();
+}
+
+void Engine::removeGameObject(EntityHandle handle) {
+    GameObject* obj;
+    {
+        std::lock_guard<std::mutex> lock(s_gameObjectsMutex);
+        obj = resolve(handle);
+        if (!obj) return; // Already destroyed
+
+        if (!findSlot(obj)) return; // Not owned by the engine
+
+        unlinkGameObject(obj);
+        publishGameObjects();
     }
+
+    ObjectList::synchronize();
+    retireGameObject(obj);
 }
 
-void Engine::queueRemove(GameObject* obj) {
+void Engine::queueRemove(EntityHandle handle) {
 	std::lock_guard<std::mutex> lock(s_gameObjectsMutex);
-	s_pendingRemovals.push_back(obj);
+	GameObject* obj = resolve(handle);
+	if (!obj) return;
+
+	// Components keep asking every frame until the flush, only queue the first request
+	if (!findSlot(obj) || obj->removalQueued.exchange(true)) return;
+
+	s_pendingRemovals.push_back(handle);
 }
 
 
 std::vector<GameObject*> Engine::getGameObjectsSnapshot() {
-    std::lock_guard<std::mutex> lock(s_gameObjectsMutex);
-    return s_gameObjects;
+    ObjectList::View objects = getGameObjects();
+    return std::vector<GameObject*>(objects.begin(), objects.end());
+}
+
+std::pmr::memory_resource* Engine::getFrameAllocator() {
+    return s_frameArena ? s_frameArena.get() : std::pmr::get_default_resource();
 }
 
 std::mutex& Engine::getGameObjectsMutex() {
@@ -115,49 +312,68 @@ SDL_Renderer* Engine::getRenderer() {
     return s_renderer;
 }
 
-void Engine::run(std::function<void(float)> update, std::function<void(void)> render) {
-	s_running = true;
-	s_workerRunning = true;
-
-	// Start background update thread
-	s_updateThread = std::thread([&]() {
-		Uint64 last = SDL_GetTicks();
-		while (s_workerRunning) {
-			Uint64 now = SDL_GetTicks();
-			float dt = (now - last) / 1000.0f;
-			last = now;
-
-			std::vector<GameObject*> snapshot;
-			std::unordered_set<GameObject*> pendingSet;
-
-			{
-				std::lock_guard<std::mutex> lock(s_gameObjectsMutex);
-				snapshot = s_gameObjects;
-
-				pendingSet = std::unordered_set<GameObject*>(
-					s_pendingRemovals.begin(),
-					s_pendingRemovals.end()
-				);
-			}
+SDL_FRect Engine::getViewRect(const Vec2& cameraOffset) {
+    int width = 0, height = 0;
+    if (s_renderer) SDL_GetCurrentRenderOutputSize(s_renderer, &width, &height);
+    return SDL_FRect{ cameraOffset.x, cameraOffset.y, static_cast<float>(width), static_cast<float>(height) };
+}
 
-			for (GameObject* obj : snapshot) {
-				if (!obj) continue;
+void Engine::step(const std::function<void(float)>& update, float deltaTime) {
+	ENGINE_PROFILE_SCOPE("Step");
+	{
+		ENGINE_PROFILE_SCOPE("Update");
+		update(deltaTime);
+	}
 
-				// Skip if object is pending removal
-				if (pendingSet.find(obj) != pendingSet.end()) continue;
+	// Systems, including the per-object Component::update pass
+	{
+		ENGINE_PROFILE_SCOPE("Systems");
+		SystemScheduler::run(deltaTime);
+	}
 
-				obj->update(dt);
-			}
+	// FLUSH REMOVALS BEFORE RENDERING, then publish this step's additions
+	ENGINE_PROFILE_SCOPE("Flush");
+	flushRemovals();
+	{
+		std::lock_guard<std::mutex> lock(s_gameObjectsMutex);
+		publishGameObjects();
+	}
+}
 
-			SDL_Delay(1);
-		}
-		});
+void Engine::run(std::function<void(float)> update, std::function<void(void)> render) {
+	s_running = true;
+
+	// Objects added before the loop started
+	{
+		std::lock_guard<std::mutex> lock(s_gameObjectsMutex);
+		publishGameObjects();
+	}
 
 	// Main thread loop: events, input, update, render
 	SDL_Event e;
-	Uint64 lastTime = SDL_GetTicks();
+	FramePacer pacer(s_headless ? 0.0 : s_targetFps);
+	double accumulator = 0.0;
+	int frame = 0;
+
+	// Headless frames advance by a fixed dt so runs are repeatable
+	const double headlessStep = s_fixedStep > 0.0 ? s_fixedStep : 1.0 / 60.0;
 
 	while (s_running) {
+		if (s_maxFrames > 0 && frame++ >= s_maxFrames) break;
+
+		// Waits out the rest of the frame budget, returns the full frame time
+		double frameTime;
+		{
+			ENGINE_PROFILE_SCOPE("Wait");
+			frameTime = pacer.wait();
+		}
+		ENGINE_PROFILE_SCOPE("Frame");
+		s_missedFrames = pacer.getMissedDeadlines();
+
+		// Last frame's scratch memory is no longer referenced
+		s_frameArena->reset();
+		if (s_headless) frameTime = headlessStep;
+
 		while (SDL_PollEvent(&e)) {
 			if (e.type == SDL_EVENT_QUIT) {
 				s_running = false;
@@ -166,39 +382,60 @@ void Engine::run(std::function<void(float)> update, std::function<void(void)> re
 
 		Input::updateKeyboardState();
 
-		Uint64 currentTime = SDL_GetTicks();
-		float deltaTime = (currentTime - lastTime) / 1000.0f;
-		lastTime = currentTime;
+		if (s_fixedStep > 0.0) {
+			accumulator += frameTime;
 
-		update(deltaTime);
-
-		// FLUSH REMOVALS BEFORE RENDERING SNAPSHOT
-		{
-			std::lock_guard<std::mutex> lock(s_gameObjectsMutex);
-			for (GameObject* obj : s_pendingRemovals) {
-				auto it = std::find(s_gameObjects.begin(), s_gameObjects.end(), obj);
-				if (it != s_gameObjects.end()) {
-					GameObjectAllocator::destroy(*it);
-					s_gameObjects.erase(it);
+			int steps = 0;
+			while (accumulator >= s_fixedStep && steps < s_maxCatchUpSteps) {
+				// Remember where everything was so rendering can blend toward the new state
+				for (auto [obj, transform] : view<TransformComponent>()) {
+					transform.storePreviousPosition();
 				}
+
+				step(update, static_cast<float>(s_fixedStep));
+				accumulator -= s_fixedStep;
+				steps++;
 			}
-			s_pendingRemovals.clear();
+
+			// Too far behind to catch up, drop the backlog instead of spiralling
+			if (accumulator >= s_fixedStep) accumulator = std::fmod(accumulator, s_fixedStep);
+
+			s_interpolationAlpha = static_cast<float>(accumulator / s_fixedStep);
 		}
+		else {
+			step(update, static_cast<float>(frameTime));
+			s_interpolationAlpha = 1.0f;
+		}
+
+		// Per component type peaks for the memory report
+		MemoryStats::sample();
+
+		// Ages the HUD string cache, before this frame queues any text
+		TextRenderer::nextFrame();
 
-		// Clear screen
-		SDL_SetRenderDrawColor(s_renderer, 255, 255, 255, 255); // white background
-		SDL_RenderClear(s_renderer);
+		// Null render path
+		if (s_headless) continue;
 
+		{
+			ENGINE_PROFILE_SCOPE("Render");
 
+			// Clear screen
+			SDL_SetRenderDrawColor(s_renderer, 255, 255, 255, 255); // white background
+			SDL_RenderClear(s_renderer);
 
-		// Extra custom rendering (e.g. HUD)
-		render();
+			// Extra custom rendering (e.g. HUD)
+			render();
+			s_spriteBatch.flush(s_renderer);
+		}
 
+		ENGINE_PROFILE_SCOPE("Present");
 		SDL_RenderPresent(s_renderer);
 	}
 
-	// Cleanup update thread
-	s_workerRunning = false;
-	if (s_updateThread.joinable()) s_updateThread.join();
+	if (pacer.getMissedDeadlines() > 0) {
+		SDL_Log("[Engine] Missed %llu of %llu frame deadlines at %.0f FPS",
+			static_cast<unsigned long long>(pacer.getMissedDeadlines()),
+			static_cast<unsigned long long>(pacer.getFrameCount()), s_targetFps);
+	}
 }
 
@@ -0,0 +1,66 @@
+#include <engine/EntityHandle.h>
+#include <iostream>
+#include <cstdlib>
+
+std::atomic<EntityRegistry::Slot*> EntityRegistry::chunks[EntityRegistry::MAX_CHUNKS] = {};
+uint32_t EntityRegistry::slotCount = 0;
+std::vector<uint32_t> EntityRegistry::freeSlots;
+std::mutex EntityRegistry::mutex;
+
+EntityRegistry::Slot* EntityRegistry::getSlot(uint32_t index) {
+    if (index / CHUNK_SIZE >= MAX_CHUNKS) return nullptr;
+    Slot* chunk = chunks[index / CHUNK_SIZE].load(std::memory_order_acquire);
+    return chunk ? &chunk[index % CHUNK_SIZE] : nullptr;
+}
+
+EntityHandle EntityRegistry::create(GameObject* obj) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    uint32_t index;
+    if (!freeSlots.empty()) {
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else {
+        index = slotCount++;
+        if (index / CHUNK_SIZE >= MAX_CHUNKS) {
+            std::cerr << "[EntityRegistry] Out of entity slots!" << std::endl;
+            std::abort();
+        }
+        if (!chunks[index / CHUNK_SIZE].load(std::memory_order_relaxed)) {
+            chunks[index / CHUNK_SIZE].store(new Slot[CHUNK_SIZE], std::memory_order_release);
+        }
+    }
+
+    Slot* slot = getSlot(index);
+    slot->object.store(obj, std::memory_order_release);
+    return EntityHandle{ index, slot->generation.load(std::memory_order_relaxed) };
+}
+
+void EntityRegistry::release(EntityHandle handle) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Slot* slot = getSlot(handle.index);
+    if (!slot || slot->generation.load(std::memory_order_relaxed) != handle.generation) return;
+
+    // Bump the generation before clearing the pointer so resolve() never pairs
+    // an old handle with whatever object takes this slot next
+    uint32_t next = handle.generation + 1;
+    if (next == 0) next = 1;
+    slot->generation.store(next, std::memory_order_release);
+    slot->object.store(nullptr, std::memory_order_release);
+    freeSlots.push_back(handle.index);
+}
+
+GameObject* EntityRegistry::resolve(EntityHandle handle) {
+    if (!handle.isValid()) return nullptr;
+
+    Slot* slot = getSlot(handle.index);
+    if (!slot || slot->generation.load(std::memory_order_acquire) != handle.generation) return nullptr;
+
+    GameObject* obj = slot->object.load(std::memory_order_acquire);
+
+    // Released while we were reading
+    if (slot->generation.load(std::memory_order_acquire) != handle.generation) return nullptr;
+    return obj;
+}
@@ -1,4 +1,5 @@
 #include <engine/EventManager.h>
+#include <engine/Profiler.h>
 
 void EventManager::subscribe(const std::string& eventType, Handler handler) {
 	listeners[eventType].push_back(handler);
@@ -18,6 +19,7 @@ void EventManager::dispatch(float currentTime) {
 
 		auto it = listeners.find(qe.event.type);
 		if (it != listeners.end()) {
+			ENGINE_PROFILE_SCOPE_DYNAMIC(qe.event.type);
 			for (auto& handler : it->second) {
 				handler(qe.event);
 			}
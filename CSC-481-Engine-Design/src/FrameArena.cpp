@@ -0,0 +1,64 @@
+#include <engine/FrameArena.h>
+#include <new>
+
+namespace {
+    constexpr size_t BUFFER_ALIGN = alignof(std::max_align_t);
+}
+
+FrameArena::FrameArena(size_t capacity) : capacity(capacity) {
+    buffer = static_cast<char*>(::operator new(capacity, std::align_val_t(BUFFER_ALIGN)));
+}
+
+FrameArena::~FrameArena() {
+    reset();
+    ::operator delete(buffer, std::align_val_t(BUFFER_ALIGN));
+}
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+    uintptr_t base = reinterpret_cast<uintptr_t>(buffer);
+    size_t current = offset.load(std::memory_order_relaxed);
+
+    while (true) {
+        size_t aligned = ((base + current + alignment - 1) & ~(alignment - 1)) - base;
+        size_t end = aligned + bytes;
+        if (end > capacity) break;
+
+        if (offset.compare_exchange_weak(current, end, std::memory_order_relaxed)) {
+            return buffer + aligned;
+        }
+    }
+
+    // Out of room this frame: take it from the heap and remember to free it on reset
+    void* ptr = ::operator new(bytes, std::align_val_t(alignment));
+    std::lock_guard<std::mutex> lock(spillMutex);
+    spills.push_back({ ptr, bytes, alignment });
+    spilledBytes += bytes;
+    return ptr;
+}
+
+size_t FrameArena::getUsedBytes() const {
+    size_t used = offset.load(std::memory_order_relaxed);
+    return used < capacity ? used : capacity;
+}
+
+void FrameArena::reset() {
+    size_t used = getUsedBytes() + spilledBytes;
+    if (used > peakBytes) peakBytes = used;
+
+    for (const Spill& spill : spills) {
+        ::operator delete(spill.ptr, spill.bytes, std::align_val_t(spill.alignment));
+    }
+
+    if (!spills.empty()) {
+        overflowCount++;
+
+        // Grow to fit the busiest frame with room to spare, once, instead of spilling every frame
+        ::operator delete(buffer, std::align_val_t(BUFFER_ALIGN));
+        capacity = used * 2;
+        buffer = static_cast<char*>(::operator new(capacity, std::align_val_t(BUFFER_ALIGN)));
+    }
+
+    spills.clear();
+    spilledBytes = 0;
+    offset.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,50 @@
+#include <engine/FramePacer.h>
+#include <thread>
+
+FramePacer::FramePacer(double targetHz, std::chrono::nanoseconds spinWindow)
+    : spinWindow(std::chrono::duration_cast<Clock::duration>(spinWindow)) {
+    lastReturn = Clock::now();
+    deadline = lastReturn;
+    setTargetRate(targetHz);
+}
+
+void FramePacer::setTargetRate(double hz) {
+    targetHz = hz > 0.0 ? hz : 0.0;
+    period = targetHz > 0.0
+        ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / targetHz))
+        : Clock::duration::zero();
+
+    // Start counting from now rather than from a deadline set at the old rate
+    deadline = Clock::now() + period;
+}
+
+double FramePacer::wait() {
+    frameCount++;
+
+    if (period > Clock::duration::zero()) {
+        Clock::time_point now = Clock::now();
+
+        if (now >= deadline) {
+            missedDeadlines++;
+
+            // More than a whole period late: resync instead of rushing frames to catch up
+            if (now - deadline > period) deadline = now;
+        }
+        else {
+            // Coarse sleep, then spin through the window the scheduler can't be trusted with
+            if (deadline - now > spinWindow) {
+                std::this_thread::sleep_until(deadline - spinWindow);
+            }
+            while (Clock::now() < deadline) {
+                std::this_thread::yield();
+            }
+        }
+
+        deadline += period;
+    }
+
+    Clock::time_point now = Clock::now();
+    double elapsed = std::chrono::duration<double>(now - lastReturn).count();
+    lastReturn = now;
+    return elapsed;
+}
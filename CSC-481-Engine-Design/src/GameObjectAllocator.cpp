@@ -1,21 +1,193 @@
 #include <engine/GameObjectAllocator.hpp>
+#include <new>
 
 GameObjectAllocator::AllocMode GameObjectAllocator::allocationMode = GameObjectAllocator::DYNAMIC;
 std::unique_ptr<GameObjectPool> GameObjectAllocator::pool = nullptr;
+std::atomic<size_t> GameObjectAllocator::liveCount{ 0 };
+std::atomic<size_t> GameObjectAllocator::highWaterMark{ 0 };
+std::atomic<uint64_t> GameObjectAllocator::failedAllocations{ 0 };
+
+namespace {
+    constexpr uint32_t MAGAZINE_SIZE = 32;
+    constexpr uint32_t REFILL_COUNT = MAGAZINE_SIZE / 2;   // leave room for the frees that follow
+    constexpr uint32_t MAGAZINE_COUNT = 1024;
+    constexpr uint32_t MAX_DEPOT_FULL = 16;                 // beyond this, full magazines drain to the pool
+    constexpr uint32_t NO_MAGAZINE = 0xFFFFFFFFu;
+
+    struct Magazine {
+        void* slots[MAGAZINE_SIZE];
+        uint32_t count = 0;
+        std::atomic<uint32_t> next{ NO_MAGAZINE };
+    };
+
+    // Treiber stack of magazine indices. The head packs a tag in the upper 32 bits that
+    // changes on every push and pop, so a pop can't be fooled by an index that left and
+    // came back between its load and its compare-exchange.
+    class MagazineStack {
+    public:
+        explicit MagazineStack(Magazine* magazines) : magazines(magazines) {}
+
+        void push(uint32_t index) {
+            uint64_t old = head.load(std::memory_order_relaxed);
+            uint64_t updated;
+            do {
+                magazines[index].next.store(static_cast<uint32_t>(old), std::memory_order_relaxed);
+                updated = ((old >> 32) + 1) << 32 | index;
+            } while (!head.compare_exchange_weak(old, updated, std::memory_order_release, std::memory_order_relaxed));
+            size.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        uint32_t pop() {
+            uint64_t old = head.load(std::memory_order_acquire);
+            uint64_t updated;
+            do {
+                uint32_t index = static_cast<uint32_t>(old);
+                if (index == NO_MAGAZINE) return NO_MAGAZINE;
+                uint32_t next = magazines[index].next.load(std::memory_order_relaxed);
+                updated = ((old >> 32) + 1) << 32 | next;
+            } while (!head.compare_exchange_weak(old, updated, std::memory_order_acquire, std::memory_order_acquire));
+            size.fetch_sub(1, std::memory_order_relaxed);
+            return static_cast<uint32_t>(old);
+        }
+
+        // Approximate, only used to cap how many slots the depot hoards
+        uint32_t approximateSize() const { return size.load(std::memory_order_relaxed); }
+
+    private:
+        Magazine* magazines;
+        std::atomic<uint64_t> head{ NO_MAGAZINE };
+        std::atomic<uint32_t> size{ 0 };
+    };
+
+    struct Depot {
+        std::unique_ptr<Magazine[]> magazines{ new Magazine[MAGAZINE_COUNT] };
+        MagazineStack full{ magazines.get() };
+        MagazineStack empty{ magazines.get() };
+
+        Depot() {
+            for (uint32_t i = MAGAZINE_COUNT; i-- > 0;) empty.push(i);
+        }
+    };
+
+    // Created with the pool and never freed, threads may still flush into it while exiting
+    Depot* depot = nullptr;
+
+    // The magazine this thread allocates from and frees into
+    struct ThreadCache {
+        uint32_t magazine = NO_MAGAZINE;
+
+        ~ThreadCache() {
+            if (!depot || magazine == NO_MAGAZINE) return;
+            if (depot->magazines[magazine].count > 0) depot->full.push(magazine);
+            else depot->empty.push(magazine);
+        }
+    };
+
+    ThreadCache& threadCache() {
+        thread_local ThreadCache cache;
+        return cache;
+    }
+}
+
+void GameObjectAllocator::setPoolCapacity(size_t capacity) {
+    if (!pool) {
+        pool = std::make_unique<GameObjectPool>(capacity);
+        if (!depot) depot = new Depot();
+    }
+}
+
+void* GameObjectAllocator::takeSlot() {
+    ThreadCache& cache = threadCache();
+    if (cache.magazine != NO_MAGAZINE) {
+        Magazine& magazine = depot->magazines[cache.magazine];
+        if (magazine.count > 0) return magazine.slots[--magazine.count];
+    }
+
+    // Out of slots: swap for a full magazine another thread freed into
+    uint32_t full = depot->full.pop();
+    if (full != NO_MAGAZINE) {
+        if (cache.magazine != NO_MAGAZINE) depot->empty.push(cache.magazine);
+        cache.magazine = full;
+        Magazine& magazine = depot->magazines[full];
+        return magazine.slots[--magazine.count];
+    }
+
+    // Nothing cached anywhere, refill from the pool in one locked batch
+    if (cache.magazine == NO_MAGAZINE) cache.magazine = depot->empty.pop();
+    if (cache.magazine == NO_MAGAZINE) return pool->allocate();
+
+    Magazine& magazine = depot->magazines[cache.magazine];
+    magazine.count = static_cast<uint32_t>(pool->allocate(magazine.slots, REFILL_COUNT));
+    return magazine.count > 0 ? magazine.slots[--magazine.count] : nullptr;
+}
+
+void GameObjectAllocator::returnSlot(void* slot) {
+    ThreadCache& cache = threadCache();
+    if (cache.magazine != NO_MAGAZINE) {
+        Magazine& magazine = depot->magazines[cache.magazine];
+        if (magazine.count < MAGAZINE_SIZE) {
+            magazine.slots[magazine.count++] = slot;
+            return;
+        }
+
+        // Full: park it in the depot for an allocating thread, or drain it if the depot
+        // already holds plenty, so the pool can still release chunks
+        if (depot->full.approximateSize() < MAX_DEPOT_FULL) {
+            depot->full.push(cache.magazine);
+            cache.magazine = depot->empty.pop();
+        }
+        else {
+            pool->deallocate(magazine.slots, magazine.count);
+            magazine.count = 0;
+        }
+    }
+    else {
+        cache.magazine = depot->empty.pop();
+    }
+
+    if (cache.magazine == NO_MAGAZINE) {
+        pool->deallocate(slot);
+        return;
+    }
+    Magazine& magazine = depot->magazines[cache.magazine];
+    magazine.slots[magazine.count++] = slot;
+}
 
 GameObject* GameObjectAllocator::create() {
+    ScopedLatency timing(MemoryStats::getObjectAllocLatency());
+
     if (allocationMode == POOLED && pool) {
-        return pool->allocate();
+        void* slot = takeSlot();
+        if (!slot) {
+            failedAllocations.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        GameObject* obj = new (slot) GameObject();
+        obj->pooled = true;
+
+        size_t live = liveCount.fetch_add(1, std::memory_order_relaxed) + 1;
+        size_t peak = highWaterMark.load(std::memory_order_relaxed);
+        while (live > peak && !highWaterMark.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+        return obj;
     }
     return new GameObject(); // Dynamic fallback
 }
 
 void GameObjectAllocator::destroy(GameObject* obj) {
     if (!obj) return;
-    
-    if (allocationMode == POOLED && pool && pool->owns(obj)) {
-        pool->deallocate(obj);
+
+    // Decided per object, so switching modes later still frees each one correctly
+    if (obj->pooled && pool) {
+        obj->~GameObject();
+        liveCount.fetch_sub(1, std::memory_order_relaxed);
+        returnSlot(obj);
     } else {
         delete obj;
     }
+}
+
+float GameObjectAllocator::getPoolUsagePercent() {
+    size_t capacity = getPoolCapacity();
+    return capacity > 0 ? (getPoolUsedCount() * 100.0f / capacity) : 0.0f;
 }
\ No newline at end of file
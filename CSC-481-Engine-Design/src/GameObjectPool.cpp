@@ -1,54 +1,171 @@
 #include <engine/GameObjectPool.hpp>
 #include <new>
 
-GameObjectPool::GameObjectPool(size_t capacity)
-    : capacity(capacity), usedCount(0) {
-    memory = static_cast<char*>(::operator new(capacity * sizeof(GameObject)));
-    used = new bool[capacity];
-    std::memset(used, 0, capacity * sizeof(bool));
+static_assert(sizeof(GameObject) >= sizeof(size_t), "free slots store the next free index");
+
+GameObjectPool::GameObjectPool(size_t chunkCapacity, size_t maxChunks)
+    : maxChunks(maxChunks) {
+    size_t wanted = (chunkCapacity > 0 ? chunkCapacity : 1) * sizeof(GameObject);
+    chunkBytes = 1;
+    while (chunkBytes < wanted) chunkBytes <<= 1;
+    objectsPerChunk = chunkBytes / sizeof(GameObject);
+
+    // Start with one chunk so the first spawns don't pay for growth
+    addChunk();
 }
 
 GameObjectPool::~GameObjectPool() {
-    for (size_t i = 0; i < capacity; i++) {
-        if (used[i]) {
-            GameObject* obj = reinterpret_cast<GameObject*>(memory + i * sizeof(GameObject));
-            obj->~GameObject();
-        }
+    // Objects must already be destroyed, the slots are just memory by now
+    for (auto& entry : chunks) {
+        Chunk* chunk = entry.second;
+        ::operator delete(chunk->memory, std::align_val_t(chunkBytes));
+        delete[] chunk->used;
+        delete chunk;
     }
-    ::operator delete(memory);
-    delete[] used;
-}
-
-GameObject* GameObjectPool::allocate() {
-    for (size_t i = 0; i < capacity; i++) {
-        if (!used[i]) {
-            used[i] = true;
-            usedCount++;
-            GameObject* ptr = reinterpret_cast<GameObject*>(memory + i * sizeof(GameObject));
-            new (ptr) GameObject();
-            return ptr;
-        }
+}
+
+GameObjectPool::Chunk* GameObjectPool::addChunk() {
+    Chunk* chunk = new Chunk();
+    chunk->memory = static_cast<char*>(::operator new(chunkBytes, std::align_val_t(chunkBytes)));
+    chunk->used = new bool[objectsPerChunk];
+    std::memset(chunk->used, 0, objectsPerChunk * sizeof(bool));
+
+    // Thread every slot onto the free list, lowest index first
+    for (size_t i = objectsPerChunk; i-- > 0;) {
+        std::memcpy(chunk->memory + i * sizeof(GameObject), &chunk->freeHead, sizeof(size_t));
+        chunk->freeHead = i;
     }
-    return nullptr;
+
+    chunks[reinterpret_cast<uintptr_t>(chunk->memory)] = chunk;
+    emptyChunks++;
+    linkAvailable(chunk);
+    return chunk;
+}
+
+void GameObjectPool::releaseChunk(Chunk* chunk) {
+    unlinkAvailable(chunk);
+    chunks.erase(reinterpret_cast<uintptr_t>(chunk->memory));
+    emptyChunks--;
+
+    ::operator delete(chunk->memory, std::align_val_t(chunkBytes));
+    delete[] chunk->used;
+    delete chunk;
+}
+
+GameObjectPool::Chunk* GameObjectPool::findChunk(const void* address) const {
+    uintptr_t base = reinterpret_cast<uintptr_t>(address) & ~static_cast<uintptr_t>(chunkBytes - 1);
+    auto it = chunks.find(base);
+    return it != chunks.end() ? it->second : nullptr;
 }
 
-void GameObjectPool::deallocate(GameObject* obj) {
-    char* objMem = reinterpret_cast<char*>(obj);
-    ptrdiff_t diff = objMem - memory;
-    size_t index = diff / sizeof(GameObject);
+void GameObjectPool::linkAvailable(Chunk* chunk) {
+    if (chunk->available) return;
+    chunk->prevAvailable = nullptr;
+    chunk->nextAvailable = availableHead;
+    if (availableHead) availableHead->prevAvailable = chunk;
+    availableHead = chunk;
+    chunk->available = true;
+}
+
+void GameObjectPool::unlinkAvailable(Chunk* chunk) {
+    if (!chunk->available) return;
+    if (chunk->prevAvailable) chunk->prevAvailable->nextAvailable = chunk->nextAvailable;
+    else availableHead = chunk->nextAvailable;
+    if (chunk->nextAvailable) chunk->nextAvailable->prevAvailable = chunk->prevAvailable;
+    chunk->prevAvailable = chunk->nextAvailable = nullptr;
+    chunk->available = false;
+}
+
+void* GameObjectPool::allocate() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return allocateLocked();
+}
+
+void GameObjectPool::deallocate(void* slot) {
+    std::lock_guard<std::mutex> lock(mutex);
+    deallocateLocked(slot);
+}
+
+size_t GameObjectPool::allocate(void** slots, size_t count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t filled = 0;
+    while (filled < count) {
+        void* slot = allocateLocked();
+        if (!slot) break;
+        slots[filled++] = slot;
+    }
+    return filled;
+}
 
-    if (index >= 0 && index < capacity && used[index]) {
-        obj->~GameObject();
-        used[index] = false;
-        usedCount--;
+void GameObjectPool::deallocate(void* const* slots, size_t count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < count; i++) {
+        deallocateLocked(slots[i]);
     }
 }
 
-bool GameObjectPool::owns(GameObject* obj) const {
-    char* objMem = reinterpret_cast<char*>(obj);
-    return objMem >= memory && objMem < memory + (capacity * sizeof(GameObject));
+void* GameObjectPool::allocateLocked() {
+    Chunk* chunk = availableHead;
+    if (!chunk) {
+        if (maxChunks > 0 && chunks.size() >= maxChunks) return nullptr;
+        chunk = addChunk();
+    }
+
+    size_t index = chunk->freeHead;
+    std::memcpy(&chunk->freeHead, chunk->memory + index * sizeof(GameObject), sizeof(size_t));
+    if (chunk->freeHead == NO_SLOT) unlinkAvailable(chunk);
+
+    if (chunk->usedCount++ == 0) emptyChunks--;
+    chunk->used[index] = true;
+    usedCount++;
+
+    return chunk->memory + index * sizeof(GameObject);
+}
+
+void GameObjectPool::deallocateLocked(void* slot) {
+    Chunk* chunk = findChunk(slot);
+    if (!chunk) return;
+
+    size_t index = (static_cast<char*>(slot) - chunk->memory) / sizeof(GameObject);
+    if (index >= objectsPerChunk || !chunk->used[index]) return;
+
+    chunk->used[index] = false;
+    usedCount--;
+
+    // Push the slot back, it's handed out again by the next allocate
+    std::memcpy(chunk->memory + index * sizeof(GameObject), &chunk->freeHead, sizeof(size_t));
+    chunk->freeHead = index;
+    linkAvailable(chunk);
+
+    if (--chunk->usedCount == 0) {
+        emptyChunks++;
+
+        // Keep the last chunk around regardless so an idle pool doesn't churn
+        if (emptyChunks > maxEmptyChunks && chunks.size() > 1) releaseChunk(chunk);
+    }
+}
+
+bool GameObjectPool::owns(const void* slot) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return findChunk(slot) != nullptr;
+}
+
+void GameObjectPool::setMaxEmptyChunks(size_t count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    maxEmptyChunks = count;
+}
+
+size_t GameObjectPool::getCapacity() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return chunks.size() * objectsPerChunk;
+}
+
+size_t GameObjectPool::getUsedCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return usedCount;
 }
 
-float GameObjectPool::getUsagePercent() const {
-    return capacity > 0 ? (usedCount * 100.0f / capacity) : 0.0f;
+size_t GameObjectPool::getChunkCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return chunks.size();
 }
\ No newline at end of file
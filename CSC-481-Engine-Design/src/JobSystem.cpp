@@ -0,0 +1,139 @@
+#include <engine/JobSystem.h>
+
+std::vector<JobSystem::Queue*> JobSystem::s_queues;
+std::vector<std::thread> JobSystem::s_workers;
+std::atomic<bool> JobSystem::s_running = false;
+std::atomic<int> JobSystem::s_queuedJobs = 0;
+std::mutex JobSystem::s_sleepMutex;
+std::condition_variable JobSystem::s_wake;
+
+namespace {
+    // Index into s_queues of the calling thread's own queue
+    thread_local unsigned localQueue = 0;
+}
+
+void JobSystem::init(unsigned workerCount) {
+    if (s_running) return;
+
+    if (workerCount == 0) {
+        unsigned hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 0;
+    }
+
+    s_queues.push_back(new Queue()); // Shared queue for non-worker threads
+    for (unsigned i = 0; i < workerCount; i++) {
+        s_queues.push_back(new Queue());
+    }
+
+    s_running = true;
+    for (unsigned i = 0; i < workerCount; i++) {
+        s_workers.emplace_back(workerLoop, i + 1);
+    }
+}
+
+void JobSystem::shutdown() {
+    if (!s_running) return;
+
+    {
+        std::lock_guard<std::mutex> lock(s_sleepMutex);
+        s_running = false;
+    }
+    s_wake.notify_all();
+
+    for (std::thread& worker : s_workers) {
+        if (worker.joinable()) worker.join();
+    }
+    s_workers.clear();
+
+    for (Queue* queue : s_queues) delete queue;
+    s_queues.clear();
+}
+
+unsigned JobSystem::getWorkerCount() {
+    return static_cast<unsigned>(s_workers.size());
+}
+
+void JobSystem::submit(void (*fn)(void*), void* context, Counter& counter) {
+    counter.fetch_add(1, std::memory_order_relaxed);
+
+    // Not initialized, or no workers: just run it
+    if (s_queues.empty()) {
+        run(Job{ fn, context, &counter });
+        return;
+    }
+
+    Queue* queue = s_queues[localQueue];
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->jobs.push_back(Job{ fn, context, &counter });
+    }
+
+    s_queuedJobs.fetch_add(1, std::memory_order_release);
+    {
+        // Taking the lock orders this with a worker that is about to sleep
+        std::lock_guard<std::mutex> lock(s_sleepMutex);
+    }
+    s_wake.notify_one();
+}
+
+void JobSystem::wait(Counter& counter) {
+    while (counter.load(std::memory_order_acquire) > 0) {
+        if (!tryRunOne()) std::this_thread::yield();
+    }
+}
+
+void JobSystem::workerLoop(unsigned index) {
+    localQueue = index;
+
+    while (true) {
+        if (tryRunOne()) continue;
+
+        std::unique_lock<std::mutex> lock(s_sleepMutex);
+        s_wake.wait(lock, [] {
+            return !s_running || s_queuedJobs.load(std::memory_order_acquire) > 0;
+        });
+        if (!s_running) return;
+    }
+}
+
+bool JobSystem::tryRunOne() {
+    Job job;
+    if (!popLocal(job) && !steal(job)) return false;
+
+    s_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+    run(job);
+    return true;
+}
+
+bool JobSystem::popLocal(Job& job) {
+    if (s_queues.empty()) return false;
+
+    // Newest first, its data is most likely still in cache
+    Queue* queue = s_queues[localQueue];
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    if (queue->jobs.empty()) return false;
+
+    job = queue->jobs.back();
+    queue->jobs.pop_back();
+    return true;
+}
+
+bool JobSystem::steal(Job& job) {
+    size_t count = s_queues.size();
+    for (size_t i = 1; i < count; i++) {
+        Queue* victim = s_queues[(localQueue + i) % count];
+        std::lock_guard<std::mutex> lock(victim->mutex);
+        if (victim->jobs.empty()) continue;
+
+        // Oldest first, usually the biggest remaining chunk of the victim's work
+        job = victim->jobs.front();
+        victim->jobs.pop_front();
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::run(const Job& job) {
+    job.fn(job.context);
+    job.counter->fetch_sub(1, std::memory_order_release);
+}
@@ -0,0 +1,147 @@
+#include <engine/MemoryStats.h>
+#include <engine/ComponentStorage.h>
+#include <engine/GameObjectAllocator.hpp>
+#include <engine/Engine.h>
+#include <cstdio>
+#include <mutex>
+
+namespace {
+    std::mutex peaksMutex;
+    std::array<size_t, MAX_COMPONENT_TYPES> peakCounts{};
+
+    void writeLatency(FILE* file, const char* label, const LatencyHistogram& histogram) {
+        std::fprintf(file, "%s: %llu samples, p50 < %llu ns, p99 < %llu ns, max < %llu ns\n", label,
+            static_cast<unsigned long long>(histogram.getCount()),
+            static_cast<unsigned long long>(histogram.percentile(0.50)),
+            static_cast<unsigned long long>(histogram.percentile(0.99)),
+            static_cast<unsigned long long>(histogram.percentile(1.0)));
+
+        for (size_t bucket = 0; bucket < LatencyHistogram::BUCKETS; bucket++) {
+            uint64_t count = histogram.getBucket(bucket);
+            if (count == 0) continue;
+            std::fprintf(file, "  < %10llu ns  %llu\n",
+                static_cast<unsigned long long>(uint64_t(1) << bucket), static_cast<unsigned long long>(count));
+        }
+    }
+}
+
+uint64_t LatencyHistogram::percentile(double fraction) const {
+    uint64_t count = getCount();
+    if (count == 0) return 0;
+
+    uint64_t target = static_cast<uint64_t>(fraction * count);
+    if (target == 0) target = 1;
+
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < BUCKETS; bucket++) {
+        seen += getBucket(bucket);
+        if (seen >= target) return uint64_t(1) << bucket;
+    }
+    return uint64_t(1) << (BUCKETS - 1);
+}
+
+std::vector<MemoryStats::ComponentTypeStats> MemoryStats::getComponentTypeStats() {
+    std::array<ComponentTypeUsage, MAX_COMPONENT_TYPES> usage;
+    ComponentStorage::getTypeUsage(usage);
+
+    std::lock_guard<std::mutex> lock(peaksMutex);
+    std::vector<ComponentTypeStats> stats;
+    for (const ComponentTypeUsage& entry : usage) {
+        if (!entry.type) continue;
+
+        size_t& peak = peakCounts[entry.type->id];
+        if (entry.liveCount > peak) peak = entry.liveCount;
+
+        stats.push_back({
+            entry.type->name,
+            entry.type->size,
+            entry.liveCount,
+            entry.liveCount * entry.type->size,
+            entry.reservedCount * entry.type->size,
+            peak
+        });
+    }
+    return stats;
+}
+
+MemoryStats::PoolStats MemoryStats::getObjectPoolStats() {
+    return {
+        GameObjectAllocator::getPoolCapacity(),
+        GameObjectAllocator::getPoolUsedCount(),
+        GameObjectAllocator::getPoolHighWaterMark(),
+        GameObjectAllocator::getPoolChunkCount(),
+        GameObjectAllocator::getFailedAllocations()
+    };
+}
+
+MemoryStats::ArenaStats MemoryStats::getFrameArenaStats() {
+    const FrameArena* arena = Engine::getFrameArena();
+    if (!arena) return { 0, 0, 0, 0 };
+    return { arena->getCapacity(), arena->getUsedBytes(), arena->getPeakBytes(), arena->getOverflowCount() };
+}
+
+LatencyHistogram& MemoryStats::getObjectAllocLatency() {
+    static auto* histogram = new LatencyHistogram();
+    return *histogram;
+}
+
+LatencyHistogram& MemoryStats::getComponentAllocLatency() {
+    static auto* histogram = new LatencyHistogram();
+    return *histogram;
+}
+
+void MemoryStats::setLatencySampling(bool enabled) {
+    getObjectAllocLatency().setEnabled(enabled);
+    getComponentAllocLatency().setEnabled(enabled);
+}
+
+bool MemoryStats::isLatencySampling() {
+    return getObjectAllocLatency().isEnabled();
+}
+
+void MemoryStats::sample() {
+    std::array<ComponentTypeUsage, MAX_COMPONENT_TYPES> usage;
+    ComponentStorage::getTypeUsage(usage);
+
+    std::lock_guard<std::mutex> lock(peaksMutex);
+    for (const ComponentTypeUsage& entry : usage) {
+        if (!entry.type) continue;
+
+        size_t& peak = peakCounts[entry.type->id];
+        if (entry.liveCount > peak) peak = entry.liveCount;
+    }
+}
+
+bool MemoryStats::writeReport(const char* path) {
+    FILE* file = std::fopen(path, "w");
+    if (!file) return false;
+
+    std::fprintf(file, "Components\n");
+    std::fprintf(file, "  %-36s %8s %8s %8s %12s %12s\n", "type", "size", "live", "peak", "live bytes", "reserved");
+    size_t totalLive = 0, totalReserved = 0;
+    for (const ComponentTypeStats& type : getComponentTypeStats()) {
+        std::fprintf(file, "  %-36s %8zu %8zu %8zu %12zu %12zu\n",
+            type.name, type.size, type.liveCount, type.peakCount, type.liveBytes, type.reservedBytes);
+        totalLive += type.liveBytes;
+        totalReserved += type.reservedBytes;
+    }
+    std::fprintf(file, "  %-36s %8s %8s %8s %12zu %12zu\n\n", "total", "", "", "", totalLive, totalReserved);
+
+    PoolStats pool = getObjectPoolStats();
+    std::fprintf(file, "GameObject pool\n");
+    std::fprintf(file, "  capacity %zu in %zu chunks, live %zu, high water %zu, failed allocations %llu\n\n",
+        pool.capacity, pool.chunks, pool.used, pool.highWaterMark,
+        static_cast<unsigned long long>(pool.failedAllocations));
+
+    ArenaStats arena = getFrameArenaStats();
+    std::fprintf(file, "Frame arena\n");
+    std::fprintf(file, "  capacity %zu bytes, peak %zu bytes, frames overflowed %zu\n\n",
+        arena.capacity, arena.peakBytes, arena.overflowFrames);
+
+    std::fprintf(file, "Allocation latency%s\n", isLatencySampling() ? "" : " (sampling off, see Config::sampleAllocLatency)");
+    writeLatency(file, "  GameObject create", getObjectAllocLatency());
+    writeLatency(file, "  Component emplace", getComponentAllocLatency());
+
+    std::fclose(file);
+    return true;
+}
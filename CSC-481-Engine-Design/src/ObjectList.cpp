@@ -0,0 +1,130 @@
+#include <engine/ObjectList.h>
+#include <iostream>
+#include <cstdlib>
+#include <thread>
+
+std::atomic<uint64_t> ObjectList::readerEpochs[ObjectList::MAX_READERS];
+std::atomic<bool> ObjectList::readerClaimed[ObjectList::MAX_READERS];
+std::atomic<uint64_t> ObjectList::globalEpoch{ 1 };
+
+namespace {
+    // Index of this thread's claimed slot, cached where unpin() can reach it
+    thread_local size_t readerSlot = SIZE_MAX;
+    thread_local int pinDepth = 0;
+}
+
+struct ObjectList::ReaderSlot {
+    size_t index = SIZE_MAX;
+
+    // Take the first free slot. Exited threads free theirs, so they are reused.
+    void claim() {
+        for (size_t i = 0; i < MAX_READERS; i++) {
+            bool expected = false;
+            if (!readerClaimed[i].load(std::memory_order_relaxed) &&
+                readerClaimed[i].compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                index = i;
+                return;
+            }
+        }
+        std::cerr << "[ObjectList] Too many reader threads!" << std::endl;
+        std::abort();
+    }
+
+    ~ReaderSlot() {
+        if (index == SIZE_MAX) return;
+        readerEpochs[index].store(IDLE, std::memory_order_release);
+        readerClaimed[index].store(false, std::memory_order_release);
+        readerSlot = SIZE_MAX;
+    }
+};
+
+ObjectList::View::View(const ObjectList& list) {
+    pin();
+    version = list.current.load(std::memory_order_seq_cst);
+}
+
+ObjectList::View::~View() {
+    unpin();
+}
+
+void ObjectList::pin() {
+    if (pinDepth++ > 0) return; // Nested views share the outer pin
+
+    if (readerSlot == SIZE_MAX) {
+        thread_local ReaderSlot slot;
+        slot.claim();
+        readerSlot = slot.index;
+    }
+
+    // seq_cst pairs with the writer's exchange: either this reader sees the new version,
+    // or the writer sees this pin and keeps the old one alive
+    readerEpochs[readerSlot].store(globalEpoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+}
+
+void ObjectList::unpin() {
+    if (--pinDepth > 0) return;
+    readerEpochs[readerSlot].store(IDLE, std::memory_order_release);
+}
+
+uint64_t ObjectList::oldestPinnedEpoch() {
+    uint64_t oldest = UINT64_MAX;
+
+    // Free slots are IDLE, so scanning every slot is correct as well as cheap
+    for (size_t i = 0; i < MAX_READERS; i++) {
+        uint64_t epoch = readerEpochs[i].load(std::memory_order_seq_cst);
+        if (epoch != IDLE && epoch < oldest) oldest = epoch;
+    }
+    return oldest;
+}
+
+ObjectList::ObjectList() : current(new Version()) {}
+
+ObjectList::~ObjectList() {
+    delete current.load();
+    for (Retired& r : retired) delete r.version;
+    for (Version* v : spare) delete v;
+}
+
+void ObjectList::publish(const std::vector<GameObject*>& objects) {
+    reclaim();
+
+    Version* next;
+    if (!spare.empty()) {
+        next = spare.back();
+        spare.pop_back();
+    }
+    else {
+        next = new Version();
+    }
+    next->objects.assign(objects.begin(), objects.end()); // Reuses the recycled capacity
+
+    // Readers that pinned at this epoch or earlier may still hold the old version
+    uint64_t epoch = globalEpoch.load(std::memory_order_seq_cst);
+    Version* old = current.exchange(next, std::memory_order_seq_cst);
+    globalEpoch.store(epoch + 1, std::memory_order_seq_cst);
+
+    retired.push_back({ old, epoch });
+}
+
+void ObjectList::synchronize() {
+    if (pinDepth > 0) {
+        std::cerr << "[ObjectList] synchronize() called while holding a View, this would never return" << std::endl;
+        std::abort();
+    }
+
+    uint64_t target = globalEpoch.load(std::memory_order_seq_cst);
+    while (oldestPinnedEpoch() < target) {
+        std::this_thread::yield();
+    }
+}
+
+void ObjectList::reclaim() {
+    uint64_t oldest = oldestPinnedEpoch();
+
+    size_t kept = 0;
+    for (Retired& r : retired) {
+        if (r.epoch < oldest) spare.push_back(r.version);
+        else retired[kept++] = r;
+    }
+    retired.resize(kept);
+}
@@ -0,0 +1,67 @@
+#include <engine/Prefab.h>
+#include <algorithm>
+
+void Prefab::insert(const ComponentTypeInfo* type, void* data) {
+    auto it = std::lower_bound(entries.begin(), entries.end(), type->id,
+        [](const Entry& entry, uint32_t id) { return entry.type->id < id; });
+
+    if (it != entries.end() && it->type->id == type->id) {
+        it->type->destroy(it->data);
+        ::operator delete(it->data, std::align_val_t(it->type->align));
+        it->data = data;
+    }
+    else {
+        entries.insert(it, Entry{ type, data });
+    }
+
+    archetype = nullptr;
+}
+
+void Prefab::clear() {
+    for (const Entry& entry : entries) {
+        entry.type->destroy(entry.data);
+        ::operator delete(entry.data, std::align_val_t(entry.type->align));
+    }
+    entries.clear();
+    archetype = nullptr;
+}
+
+void Prefab::setRecycling(bool enabled, size_t maxParked) {
+    std::lock_guard<std::mutex> lock(parkMutex);
+    recycling = enabled;
+    this->maxParked = maxParked;
+}
+
+bool Prefab::isRecycling() const {
+    std::lock_guard<std::mutex> lock(parkMutex);
+    return recycling;
+}
+
+size_t Prefab::getParkedCount() const {
+    std::lock_guard<std::mutex> lock(parkMutex);
+    return parked.size();
+}
+
+bool Prefab::park(GameObject* obj) {
+    std::lock_guard<std::mutex> lock(parkMutex);
+    if (!recycling || parked.size() >= maxParked) return false;
+
+    parked.push_back(obj);
+    return true;
+}
+
+GameObject* Prefab::unpark() {
+    std::lock_guard<std::mutex> lock(parkMutex);
+    if (parked.empty()) return nullptr;
+
+    GameObject* obj = parked.back();
+    parked.pop_back();
+    return obj;
+}
+
+std::vector<GameObject*> Prefab::takeParked() {
+    std::lock_guard<std::mutex> lock(parkMutex);
+    std::vector<GameObject*> taken;
+    taken.swap(parked);
+    return taken;
+}
@@ -0,0 +1,139 @@
+#include <engine/Profiler.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+    struct Zone {
+        const char* name;
+        uint64_t start;
+        uint64_t end;
+    };
+
+    // Ring entry. Relaxed atomics so a dump can copy entries while the owner overwrites them;
+    // the dump then throws away whatever may have been overwritten mid-copy.
+    struct ZoneSlot {
+        std::atomic<const char*> name{ nullptr };
+        std::atomic<uint64_t> start{ 0 };
+        std::atomic<uint64_t> end{ 0 };
+    };
+
+    // Written only by its own thread. head counts every zone ever recorded, so the
+    // live window is the last RING_CAPACITY entries before it.
+    struct ThreadBuffer {
+        uint32_t threadId = 0;
+        std::atomic<uint64_t> head{ 0 };
+        std::unique_ptr<ZoneSlot[]> zones{ new ZoneSlot[Profiler::RING_CAPACITY] };
+    };
+
+    // Buffers outlive their threads so a dump still sees zones from finished workers
+    std::mutex& registryMutex() {
+        static auto* mutex = new std::mutex();
+        return *mutex;
+    }
+
+    std::vector<ThreadBuffer*>& buffers() {
+        static auto* list = new std::vector<ThreadBuffer*>();
+        return *list;
+    }
+
+    ThreadBuffer& localBuffer() {
+        thread_local ThreadBuffer* buffer = [] {
+            auto* created = new ThreadBuffer();
+            std::lock_guard<std::mutex> lock(registryMutex());
+            created->threadId = static_cast<uint32_t>(buffers().size());
+            buffers().push_back(created);
+            return created;
+        }();
+        return *buffer;
+    }
+
+    // Escape the few characters that can show up in type names and event strings
+    void writeJsonString(FILE* file, const char* text) {
+        std::fputc('"', file);
+        for (const char* c = text; *c; c++) {
+            if (*c == '"' || *c == '\\') std::fputc('\\', file);
+            if (static_cast<unsigned char>(*c) >= 0x20) std::fputc(*c, file);
+        }
+        std::fputc('"', file);
+    }
+}
+
+uint64_t Profiler::now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void Profiler::record(const char* name, uint64_t startNs, uint64_t endNs) {
+    ThreadBuffer& buffer = localBuffer();
+    uint64_t index = buffer.head.load(std::memory_order_relaxed);
+    ZoneSlot& slot = buffer.zones[index % RING_CAPACITY];
+
+    // Keeps the previous head store ahead of these, so a dump that reads any of them also
+    // reads a head that shows this slot's old zone is being replaced
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.start.store(startNs, std::memory_order_relaxed);
+    slot.end.store(endNs, std::memory_order_relaxed);
+    buffer.head.store(index + 1, std::memory_order_release);
+}
+
+const char* Profiler::intern(const std::string& name) {
+    static auto* strings = new std::unordered_set<std::string>();
+    static auto* mutex = new std::mutex();
+
+    std::lock_guard<std::mutex> lock(*mutex);
+    return strings->insert(name).first->c_str();
+}
+
+bool Profiler::writeChromeTrace(const char* path) {
+    FILE* file = std::fopen(path, "w");
+    if (!file) return false;
+
+    std::fputs("{\"traceEvents\":[\n", file);
+    bool first = true;
+
+    std::vector<Zone> snapshot;
+    snapshot.reserve(RING_CAPACITY);
+    std::lock_guard<std::mutex> lock(registryMutex());
+    for (ThreadBuffer* buffer : buffers()) {
+        // Copy the ring first, the owner keeps recording while we read
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t begin = head > RING_CAPACITY ? head - RING_CAPACITY : 0;
+
+        snapshot.clear();
+        for (uint64_t i = begin; i < head; i++) {
+            const ZoneSlot& slot = buffer->zones[i % RING_CAPACITY];
+            snapshot.push_back(Zone{ slot.name.load(std::memory_order_relaxed),
+                slot.start.load(std::memory_order_relaxed), slot.end.load(std::memory_order_relaxed) });
+        }
+
+        // The owner may be writing entry `after` now, into the slot of entry after - RING_CAPACITY.
+        // That entry and everything older could have changed under the copy.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t after = buffer->head.load(std::memory_order_relaxed);
+        uint64_t firstIntact = after >= RING_CAPACITY ? after - RING_CAPACITY + 1 : 0;
+        size_t skip = firstIntact > begin ? static_cast<size_t>(std::min(firstIntact - begin, head - begin)) : 0;
+
+        for (size_t i = skip; i < snapshot.size(); i++) {
+            const Zone& zone = snapshot[i];
+
+            // Complete ("X") events, timestamps in microseconds
+            std::fputs(first ? "" : ",\n", file);
+            std::fputs("{\"name\":", file);
+            writeJsonString(file, zone.name);
+            std::fprintf(file, ",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                buffer->threadId, zone.start / 1000.0, (zone.end - zone.start) / 1000.0);
+            first = false;
+        }
+    }
+
+    std::fputs("\n]}\n", file);
+    std::fclose(file);
+    return true;
+}
@@ -2,87 +2,65 @@
 #include <engine/TransformComponent.h>
 #include <engine/GameObject.h>
 #include <engine/Engine.h>
-#include <SDL3_image/SDL_image.h>
-#include <iostream>
+#include <engine/TextureCache.h>
+#include <algorithm>
 
 RenderComponent::RenderComponent(const std::string& texturePath, bool tile)
     : tileTexture(tile)
 {
-
-    SDL_Renderer* renderer = Engine::getRenderer();
-    if (!renderer) {
-        std::cerr << "[RenderComponent] Renderer is null!" << std::endl;
-        return;
-    }
-
-    SDL_Surface* surface = IMG_Load(texturePath.c_str());
-    if (!surface) {
-        std::cerr << "[RenderComponent] Failed to load texture from " << texturePath << ": " << SDL_GetError() << std::endl;
-        return;
-    }
-
-    texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_DestroySurface(surface);
-
-    if (!texture) {
-        std::cerr << "[RenderComponent] Failed to create texture from " << texturePath << ": " << SDL_GetError() << std::endl;
-    }
+    TextureRegion region = TextureCache::getRegion(texturePath);
+    texture = std::move(region.texture);
+    source = region.source;
 }
 
-RenderComponent::~RenderComponent() {
-    if (texture) {
-        SDL_DestroyTexture(texture);
-        texture = nullptr;
-    }
-}
-
-void RenderComponent::draw(GameObject& obj, SDL_Renderer* renderer) {
+template <typename Fn>
+void RenderComponent::forEachQuad(GameObject& obj, const SDL_FRect& view, bool cull, Fn&& fn) {
     auto* transform = obj.getComponent<TransformComponent>();
     if (!transform || !texture) return;
 
-    Vec2 pos = transform->getPosition();
+    Vec2 pos = transform->getInterpolatedPosition(Engine::getInterpolationAlpha());
     Vec2 size = transform->getSize();
-
-    float texW = 0, texH = 0;
-    SDL_GetTextureSize(texture, &texW, &texH);
+    float viewRight = view.x + view.w;
+    float viewBottom = view.y + view.h;
 
     if (tileTexture) {
-            for (float x = pos.x; x < pos.x + size.x; x += texW) {
-                SDL_FRect dest = { 
-                    x, 
-                    pos.y,
-                    static_cast<float>(texW),
-                    static_cast<float>(texH) };
-                SDL_RenderTexture(renderer, texture, nullptr, &dest);
-            }
+        // One tile per image width, the image's own size rather than the object's
+        if (source.w <= 0) return;
+
+        float end = pos.x + size.x;
+        int first = 0;
+        if (cull) {
+            if (pos.y >= viewBottom || pos.y + source.h <= view.y) return;
+
+            // Start at the tile under the view's left edge and stop at its right edge
+            if (view.x > pos.x) first = static_cast<int>((view.x - pos.x) / source.w);
+            end = std::min(end, viewRight);
+        }
+
+        for (float x = pos.x + first * source.w; x < end; x += source.w) {
+            fn(SDL_FRect{ x - view.x, pos.y - view.y, source.w, source.h });
+        }
     } else {
-        SDL_FRect dst = { pos.x, pos.y, size.x, size.y };
-        SDL_RenderTexture(renderer, texture, nullptr, &dst);
+        if (cull && (pos.x >= viewRight || pos.x + size.x <= view.x ||
+                     pos.y >= viewBottom || pos.y + size.y <= view.y)) return;
+
+        fn(SDL_FRect{ pos.x - view.x, pos.y - view.y, size.x, size.y });
     }
 }
 
-void RenderComponent::draw(GameObject& obj, SDL_Renderer* renderer, const Vec2& cameraOffset) {
-    auto* transform = obj.getComponent<TransformComponent>();
-    if (!transform || !texture) return;
-
-    Vec2 pos = transform->getPosition();
-    Vec2 size = transform->getSize();
+void RenderComponent::draw(GameObject& obj, SDL_Renderer* renderer) {
+    draw(obj, renderer, Vec2{ 0.f, 0.f });
+}
 
-    float texW = 0, texH = 0;
-    SDL_GetTextureSize(texture, &texW, &texH);
+void RenderComponent::draw(GameObject& obj, SDL_Renderer* renderer, const Vec2& cameraOffset) {
+    SDL_FRect origin = { cameraOffset.x, cameraOffset.y, 0.f, 0.f };
+    forEachQuad(obj, origin, false, [&](const SDL_FRect& dst) {
+        SDL_RenderTexture(renderer, texture.get(), &source, &dst);
+    });
+}
 
-    if (tileTexture) {
-            for (float x = pos.x; x < pos.x + size.x; x += texW) {
-                SDL_FRect dest = { 
-                    x - cameraOffset.x, 
-                    pos.y - cameraOffset.y, 
-                    static_cast<float>(texW), 
-                    static_cast<float>(texH) 
-                };
-                SDL_RenderTexture(renderer, texture, nullptr, &dest);
-            }
-    } else {
-        SDL_FRect dst = { pos.x - cameraOffset.x, pos.y - cameraOffset.y, size.x, size.y };
-        SDL_RenderTexture(renderer, texture, nullptr, &dst);
-    }
+void RenderComponent::draw(GameObject& obj, SpriteBatch& batch, const SDL_FRect& view) {
+    forEachQuad(obj, view, true, [&](const SDL_FRect& dst) {
+        batch.draw(texture.get(), dst, &source);
+    });
 }
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include <engine/SpriteBatch.h>
+
+void SpriteBatch::draw(SDL_Texture* texture, const SDL_FRect& dst, const SDL_FRect* src, SDL_FColor color) {
+    if (!texture) return;
+
+    SDL_FRect uv = { 0.0f, 0.0f, 1.0f, 1.0f };
+    if (src) {
+        float texW = 0, texH = 0;
+        SDL_GetTextureSize(texture, &texW, &texH);
+        if (texW > 0 && texH > 0) {
+            uv = { src->x / texW, src->y / texH, src->w / texW, src->h / texH };
+        }
+    }
+
+    sprites.push_back(Sprite{ texture, dst, uv, color });
+}
+
+void SpriteBatch::flush(SDL_Renderer* renderer) {
+    lastSpriteCount = sprites.size();
+    lastDrawCalls = 0;
+    if (sprites.empty()) return;
+
+    vertices.resize(sprites.size() * 4);
+    for (size_t i = 0; i < sprites.size(); i++) {
+        const Sprite& s = sprites[i];
+        float left = s.dst.x, top = s.dst.y, right = s.dst.x + s.dst.w, bottom = s.dst.y + s.dst.h;
+        float u0 = s.uv.x, v0 = s.uv.y, u1 = s.uv.x + s.uv.w, v1 = s.uv.y + s.uv.h;
+
+        SDL_Vertex* quad = &vertices[i * 4];
+        quad[0] = SDL_Vertex{ { left, top }, s.color, { u0, v0 } };
+        quad[1] = SDL_Vertex{ { right, top }, s.color, { u1, v0 } };
+        quad[2] = SDL_Vertex{ { right, bottom }, s.color, { u1, v1 } };
+        quad[3] = SDL_Vertex{ { left, bottom }, s.color, { u0, v1 } };
+    }
+
+    // Every group starts at its own vertex offset, so one index pattern serves them all
+    size_t quadsIndexed = indices.size() / 6;
+    if (quadsIndexed < sprites.size()) {
+        indices.reserve(sprites.size() * 6);
+        for (size_t q = quadsIndexed; q < sprites.size(); q++) {
+            int base = static_cast<int>(q * 4);
+            indices.insert(indices.end(), { base, base + 1, base + 2, base + 2, base + 3, base });
+        }
+    }
+
+    // Submit in queue order, one call per run of the same texture
+    size_t first = 0;
+    while (first < sprites.size()) {
+        size_t last = first + 1;
+        while (last < sprites.size() && sprites[last].texture == sprites[first].texture) last++;
+
+        int quads = static_cast<int>(last - first);
+        SDL_RenderGeometry(renderer, sprites[first].texture,
+            &vertices[first * 4], quads * 4, indices.data(), quads * 6);
+        lastDrawCalls++;
+
+        first = last;
+    }
+
+    sprites.clear();
+}
@@ -0,0 +1,88 @@
+#include <engine/SystemScheduler.h>
+#include <engine/ComponentStorage.h>
+#include <engine/Profiler.h>
+
+std::vector<std::unique_ptr<System>> SystemScheduler::s_systems;
+std::vector<std::unique_ptr<SystemScheduler::Node>> SystemScheduler::s_nodes;
+bool SystemScheduler::s_dirty = false;
+std::atomic<ComponentMask> SystemScheduler::s_replacedMask{ 0 };
+float SystemScheduler::s_deltaTime = 0.0f;
+JobSystem::Counter SystemScheduler::s_pending{ 0 };
+
+System* SystemScheduler::add(std::unique_ptr<System> system) {
+    System* added = system.get();
+    s_systems.push_back(std::move(system));
+    s_replacedMask.fetch_or(added->getReplaced(), std::memory_order_release);
+    s_dirty = true;
+    return added;
+}
+
+void SystemScheduler::clear() {
+    s_nodes.clear();
+    s_systems.clear();
+    s_replacedMask.store(0, std::memory_order_release);
+    s_dirty = false;
+}
+
+void SystemScheduler::build() {
+    s_nodes.clear();
+    for (auto& system : s_systems) {
+        auto node = std::make_unique<Node>();
+        node->system = system.get();
+        s_nodes.push_back(std::move(node));
+    }
+
+    // Registration order decides which of two conflicting systems goes first
+    for (size_t later = 0; later < s_nodes.size(); later++) {
+        for (size_t earlier = 0; earlier < later; earlier++) {
+            if (!s_nodes[earlier]->system->conflictsWith(*s_nodes[later]->system)) continue;
+            s_nodes[earlier]->successors.push_back(later);
+            s_nodes[later]->dependencies++;
+        }
+    }
+    s_dirty = false;
+}
+
+void SystemScheduler::run(float deltaTime) {
+    if (s_systems.empty()) return;
+    if (s_dirty) build();
+
+    s_deltaTime = deltaTime;
+    for (auto& node : s_nodes) {
+        node->remaining.store(node->dependencies, std::memory_order_relaxed);
+    }
+
+    // Structural changes can only come from a structural system, which never overlaps
+    // another one, so views inside the other systems don't need the storage lock.
+    // runNode turns this off for the length of each structural system.
+    ComponentStorage::setSharedReads(true);
+
+    for (auto& node : s_nodes) {
+        if (node->dependencies == 0) JobSystem::submit(runNode, node.get(), s_pending);
+    }
+    JobSystem::wait(s_pending);
+
+    ComponentStorage::setSharedReads(false);
+}
+
+void SystemScheduler::runNode(void* context) {
+    Node* node = static_cast<Node*>(context);
+
+    // A structural system runs alone but can fan out into jobs of its own, where one job
+    // spawns while its siblings read, so its views have to take the lock again
+    bool structural = node->system->isStructural();
+    if (structural) ComponentStorage::setSharedReads(false);
+    {
+        ENGINE_PROFILE_SCOPE(node->system->getName());
+        node->system->update(s_deltaTime);
+    }
+    if (structural) ComponentStorage::setSharedReads(true);
+
+    // Queue successors before this job counts as done so s_pending never hits zero early
+    for (size_t successor : node->successors) {
+        Node* next = s_nodes[successor].get();
+        if (next->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            JobSystem::submit(runNode, next, s_pending);
+        }
+    }
+}
@@ -0,0 +1,212 @@
+#include <engine/TextRenderer.h>
+#include <engine/Engine.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    constexpr uint32_t FIRST_GLYPH = 32;   // space
+    constexpr uint32_t LAST_GLYPH = 126;   // '~', anything outside is drawn as '?'
+    constexpr int ATLAS_WIDTH = 512;
+
+    // A label drawn unchanged at the same spot on this many frames in a row gets its own texture
+    constexpr uint32_t PROMOTE_AFTER_FRAMES = 30;
+    // Cached strings and label slots not drawn for this long are dropped, checked once per period
+    constexpr uint64_t EVICT_AFTER_FRAMES = 300;
+
+    using TexturePtr = std::unique_ptr<SDL_Texture, decltype(&SDL_DestroyTexture)>;
+
+    struct Glyph {
+        SDL_FRect source{ 0.0f, 0.0f, 0.0f, 0.0f };
+        float advance = 0.0f;
+    };
+
+    struct CachedString {
+        TexturePtr texture{ nullptr, SDL_DestroyTexture };
+        float width = 0.0f;
+        float height = 0.0f;
+        uint64_t lastFrame = 0;
+    };
+
+    // What was last drawn at one position. A label is only cached once its slot has held
+    // the same text long enough, so text that changes every frame never reaches the map.
+    struct LabelSlot {
+        float x = 0.0f;
+        float y = 0.0f;
+        std::string text;   // reassigned in place, keeps its capacity
+        uint64_t lastFrame = 0;
+        uint32_t streak = 0;   // consecutive frames drawn with this text
+    };
+
+    struct FontCache {
+        TexturePtr atlas{ nullptr, SDL_DestroyTexture };
+        std::array<Glyph, LAST_GLYPH - FIRST_GLYPH + 1> glyphs;
+        std::unordered_map<std::string, CachedString> strings;
+        std::vector<LabelSlot> slots;   // a handful of HUD positions, scanned linearly
+    };
+
+    // Render thread only
+    std::unordered_map<TTF_Font*, std::unique_ptr<FontCache>> fonts;
+    uint64_t frame = 0;
+
+    SDL_Surface* toRGBA(SDL_Surface* surface) {
+        if (!surface) return nullptr;
+        SDL_Surface* converted = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
+        SDL_DestroySurface(surface);
+        return converted;
+    }
+
+    // Rasterize every printable glyph once and lay them out in rows on one texture
+    void buildAtlas(SDL_Renderer* renderer, TTF_Font* font, FontCache& cache) {
+        SDL_Color white = { 255, 255, 255, 255 };
+        std::array<SDL_Surface*, LAST_GLYPH - FIRST_GLYPH + 1> surfaces{};
+
+        int x = 0, y = 0, rowHeight = 0;
+        for (uint32_t ch = FIRST_GLYPH; ch <= LAST_GLYPH; ch++) {
+            Glyph& glyph = cache.glyphs[ch - FIRST_GLYPH];
+            int advance = 0;
+            if (TTF_GetGlyphMetrics(font, ch, nullptr, nullptr, nullptr, nullptr, &advance)) {
+                glyph.advance = static_cast<float>(advance);
+            }
+
+            SDL_Surface* surface = toRGBA(TTF_RenderGlyph_Blended(font, ch, white));
+            surfaces[ch - FIRST_GLYPH] = surface;
+            if (!surface) continue;
+
+            if (x + surface->w > ATLAS_WIDTH) {
+                x = 0;
+                y += rowHeight + 1;
+                rowHeight = 0;
+            }
+            glyph.source = { static_cast<float>(x), static_cast<float>(y),
+                             static_cast<float>(surface->w), static_cast<float>(surface->h) };
+            x += surface->w + 1;
+            rowHeight = std::max(rowHeight, surface->h);
+        }
+
+        SDL_Surface* page = SDL_CreateSurface(ATLAS_WIDTH, std::max(1, y + rowHeight), SDL_PIXELFORMAT_RGBA32);
+        if (page) {
+            SDL_FillSurfaceRect(page, nullptr, 0);
+            for (uint32_t ch = FIRST_GLYPH; ch <= LAST_GLYPH; ch++) {
+                SDL_Surface* surface = surfaces[ch - FIRST_GLYPH];
+                if (!surface) continue;
+
+                const SDL_FRect& source = cache.glyphs[ch - FIRST_GLYPH].source;
+                SDL_Rect dst = { static_cast<int>(source.x), static_cast<int>(source.y), surface->w, surface->h };
+                SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+                SDL_BlitSurface(surface, nullptr, page, &dst);
+            }
+            cache.atlas.reset(SDL_CreateTextureFromSurface(renderer, page));
+            SDL_DestroySurface(page);
+        }
+
+        for (SDL_Surface* surface : surfaces) {
+            if (surface) SDL_DestroySurface(surface);
+        }
+    }
+
+    FontCache& getFontCache(SDL_Renderer* renderer, TTF_Font* font) {
+        std::unique_ptr<FontCache>& cache = fonts[font];
+        if (!cache) {
+            cache = std::make_unique<FontCache>();
+            buildAtlas(renderer, font, *cache);
+        }
+        return *cache;
+    }
+}
+
+void TextRenderer::draw(TTF_Font* font, const char* text, SDL_Color color, float x, float y) {
+    SDL_Renderer* renderer = Engine::getRenderer();
+    if (!renderer || !font || !text || !*text) return;
+
+    FontCache& cache = getFontCache(renderer, font);
+    SpriteBatch& batch = Engine::getSpriteBatch();
+    SDL_FColor tint = { color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f };
+
+    // Reused so looking up a label doesn't allocate
+    static std::string key;
+    key.assign(text);
+
+    CachedString* entry = nullptr;
+    auto found = cache.strings.find(key);
+    if (found != cache.strings.end()) {
+        entry = &found->second;
+    }
+    else {
+        LabelSlot* slot = nullptr;
+        for (LabelSlot& candidate : cache.slots) {
+            if (candidate.x == x && candidate.y == y) { slot = &candidate; break; }
+        }
+        if (!slot) {
+            cache.slots.push_back(LabelSlot{ x, y });
+            slot = &cache.slots.back();
+        }
+
+        if (slot->lastFrame != frame || slot->text != key) {
+            bool repeated = slot->lastFrame + 1 == frame && slot->text == key;
+            slot->streak = repeated ? slot->streak + 1 : 1;
+            slot->lastFrame = frame;
+            if (!repeated) slot->text.assign(key);
+        }
+
+        if (slot->streak >= PROMOTE_AFTER_FRAMES) {
+            SDL_Color white = { 255, 255, 255, 255 };
+            SDL_Surface* surface = TTF_RenderText_Blended(font, text, 0, white);
+            if (surface) {
+                entry = &cache.strings[key];
+                entry->texture.reset(SDL_CreateTextureFromSurface(renderer, surface));
+                entry->width = static_cast<float>(surface->w);
+                entry->height = static_cast<float>(surface->h);
+                SDL_DestroySurface(surface);
+            }
+        }
+    }
+
+    if (entry && entry->texture) {
+        entry->lastFrame = frame;
+        batch.draw(entry->texture.get(), SDL_FRect{ x, y, entry->width, entry->height }, nullptr, tint);
+        return;
+    }
+
+    if (!cache.atlas) return;
+    float penX = x;
+    for (const char* c = text; *c; c++) {
+        uint32_t ch = static_cast<unsigned char>(*c);
+        if (ch < FIRST_GLYPH || ch > LAST_GLYPH) ch = '?';
+
+        const Glyph& glyph = cache.glyphs[ch - FIRST_GLYPH];
+        if (glyph.source.w > 0) {
+            batch.draw(cache.atlas.get(), SDL_FRect{ penX, y, glyph.source.w, glyph.source.h }, &glyph.source, tint);
+        }
+        penX += glyph.advance;
+    }
+}
+
+void TextRenderer::nextFrame() {
+    frame++;
+    if (frame % EVICT_AFTER_FRAMES != 0) return;
+
+    // Drop textures for labels that stopped showing, and positions nothing is drawn at
+    for (auto& [font, cache] : fonts) {
+        for (auto it = cache->strings.begin(); it != cache->strings.end();) {
+            if (frame - it->second.lastFrame > EVICT_AFTER_FRAMES) it = cache->strings.erase(it);
+            else ++it;
+        }
+        cache->slots.erase(std::remove_if(cache->slots.begin(), cache->slots.end(),
+            [](const LabelSlot& slot) { return frame - slot.lastFrame > EVICT_AFTER_FRAMES; }),
+            cache->slots.end());
+    }
+}
+
+void TextRenderer::releaseFont(TTF_Font* font) {
+    fonts.erase(font);
+}
+
+void TextRenderer::clear() {
+    fonts.clear();
+}
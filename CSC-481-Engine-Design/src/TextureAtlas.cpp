@@ -0,0 +1,120 @@
+#include <engine/TextureAtlas.h>
+#include <engine/TextureCache.h>
+#include <engine/Engine.h>
+#include <SDL3_image/SDL_image.h>
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    struct Image {
+        const std::string* path;
+        SDL_Surface* surface;
+        int page = -1;
+        int x = 0;
+        int y = 0;
+    };
+
+    // Next-fit shelf packing: tallest images first, left to right along a shelf, a new shelf
+    // when the row is full and a new page when the shelves reach the bottom. Returns pages used.
+    int packShelves(std::vector<Image>& images, int pageSize, int padding) {
+        std::sort(images.begin(), images.end(), [](const Image& a, const Image& b) {
+            return a.surface->h != b.surface->h ? a.surface->h > b.surface->h : a.surface->w > b.surface->w;
+        });
+
+        int page = 0, x = padding, shelfY = padding, shelfHeight = 0;
+        bool pageUsed = false;
+        for (Image& image : images) {
+            int w = image.surface->w, h = image.surface->h;
+            if (w + 2 * padding > pageSize || h + 2 * padding > pageSize) continue;
+
+            if (x + w + padding > pageSize) {
+                shelfY += shelfHeight + padding;
+                x = padding;
+                shelfHeight = 0;
+            }
+            if (shelfY + h + padding > pageSize) {
+                page++;
+                x = padding;
+                shelfY = padding;
+                shelfHeight = 0;
+            }
+
+            image.page = page;
+            image.x = x;
+            image.y = shelfY;
+            pageUsed = true;
+
+            x += w + padding;
+            shelfHeight = std::max(shelfHeight, h);
+        }
+        return pageUsed ? page + 1 : 0;
+    }
+}
+
+int TextureAtlas::build(const std::vector<std::string>& paths, int pageSize, int padding) {
+    SDL_Renderer* renderer = Engine::getRenderer();
+    if (!renderer) return 0;   // headless, nothing is drawn
+
+    std::vector<Image> images;
+    for (const std::string& path : paths) {
+        SDL_Surface* loaded = IMG_Load(path.c_str());
+        if (!loaded) {
+            std::cerr << "[TextureAtlas] Failed to load " << path << ": " << SDL_GetError() << std::endl;
+            continue;
+        }
+
+        // One pixel format for every page, and copy pixels as they are rather than blend them
+        SDL_Surface* converted = SDL_ConvertSurface(loaded, SDL_PIXELFORMAT_RGBA32);
+        SDL_DestroySurface(loaded);
+        if (!converted) continue;
+        SDL_SetSurfaceBlendMode(converted, SDL_BLENDMODE_NONE);
+
+        images.push_back(Image{ &path, converted });
+    }
+
+    int pageCount = packShelves(images, pageSize, padding);
+
+    for (int page = 0; page < pageCount; page++) {
+        // Trim the page to what its images actually cover
+        int width = 0, height = 0;
+        for (const Image& image : images) {
+            if (image.page != page) continue;
+            width = std::max(width, image.x + image.surface->w + padding);
+            height = std::max(height, image.y + image.surface->h + padding);
+        }
+
+        SDL_Surface* pageSurface = SDL_CreateSurface(width, height, SDL_PIXELFORMAT_RGBA32);
+        if (!pageSurface) {
+            std::cerr << "[TextureAtlas] Failed to create page: " << SDL_GetError() << std::endl;
+            continue;
+        }
+        SDL_FillSurfaceRect(pageSurface, nullptr, 0);
+
+        for (const Image& image : images) {
+            if (image.page != page) continue;
+            SDL_Rect dst = { image.x, image.y, image.surface->w, image.surface->h };
+            SDL_BlitSurface(image.surface, nullptr, pageSurface, &dst);
+        }
+
+        TextureCache::Handle texture(SDL_CreateTextureFromSurface(renderer, pageSurface), SDL_DestroyTexture);
+        SDL_DestroySurface(pageSurface);
+        if (!texture) {
+            std::cerr << "[TextureAtlas] Failed to create page texture: " << SDL_GetError() << std::endl;
+            continue;
+        }
+
+        for (const Image& image : images) {
+            if (image.page != page) continue;
+            SDL_FRect source = {
+                static_cast<float>(image.x), static_cast<float>(image.y),
+                static_cast<float>(image.surface->w), static_cast<float>(image.surface->h)
+            };
+            TextureCache::addRegion(*image.path, texture, source);
+        }
+    }
+
+    for (Image& image : images) {
+        SDL_DestroySurface(image.surface);
+    }
+    return pageCount;
+}
@@ -0,0 +1,132 @@
+#include <engine/TextureCache.h>
+#include <engine/Engine.h>
+#include <SDL3_image/SDL_image.h>
+#include <iostream>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+    // Lookups can come from any thread, spawning objects from jobs copies their RenderComponents
+    std::mutex cacheMutex;
+    std::unordered_map<std::string, TextureCache::Handle> textures;
+    std::unordered_map<std::string, TextureRegion> regions;
+
+    TextureCache::Handle load(const std::string& path) {
+        SDL_Renderer* renderer = Engine::getRenderer();
+        if (!renderer) {
+            std::cerr << "[TextureCache] Renderer is null!" << std::endl;
+            return nullptr;
+        }
+
+        SDL_Surface* surface = IMG_Load(path.c_str());
+        if (!surface) {
+            std::cerr << "[TextureCache] Failed to load texture from " << path << ": " << SDL_GetError() << std::endl;
+            return nullptr;
+        }
+
+        TextureCache::Handle texture(SDL_CreateTextureFromSurface(renderer, surface), SDL_DestroyTexture);
+        SDL_DestroySurface(surface);
+
+        if (!texture) {
+            std::cerr << "[TextureCache] Failed to create texture from " << path << ": " << SDL_GetError() << std::endl;
+            return nullptr;
+        }
+        return texture;
+    }
+}
+
+TextureCache::Handle TextureCache::get(const std::string& path) {
+    // Nothing to draw with, skip the load entirely
+    if (Engine::isHeadless()) return nullptr;
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = textures.find(path);
+    if (it != textures.end()) return it->second;
+
+    // A load uploads through the renderer, which belongs to the main thread. Textures for
+    // objects spawned from jobs have to be preloaded or packed into the atlas at setup.
+    bool mainThread = Engine::isMainThread();
+    SDL_assert(mainThread && "TextureCache miss off the main thread");
+    if (!mainThread) {
+        std::cerr << "[TextureCache] " << path << " wasn't loaded before use off the main thread" << std::endl;
+        return nullptr;
+    }
+
+    Handle texture = load(path);
+    textures.emplace(path, texture);
+    return texture;
+}
+
+TextureRegion TextureCache::getRegion(const std::string& path) {
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto it = regions.find(path);
+        if (it != regions.end()) return it->second;
+    }
+
+    TextureRegion region;
+    region.texture = get(path);
+    if (region.texture) {
+        SDL_GetTextureSize(region.texture.get(), &region.source.w, &region.source.h);
+    }
+    return region;
+}
+
+void TextureCache::addRegion(const std::string& path, Handle page, const SDL_FRect& source) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    regions[path] = TextureRegion{ std::move(page), source };
+}
+
+bool TextureCache::preload(const std::string& path) {
+    return get(path) != nullptr;
+}
+
+void TextureCache::evict(const std::string& path) {
+    Handle released;
+    TextureRegion releasedRegion;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto it = textures.find(path);
+        if (it != textures.end()) {
+            released = std::move(it->second);
+            textures.erase(it);
+        }
+
+        auto region = regions.find(path);
+        if (region != regions.end()) {
+            releasedRegion = std::move(region->second);
+            regions.erase(region);
+        }
+    }
+    // Destroyed here, outside the lock, if nobody else holds them
+}
+
+size_t TextureCache::evictUnused() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    size_t evicted = 0;
+    for (auto it = textures.begin(); it != textures.end();) {
+        if (it->second.use_count() <= 1) {
+            it = textures.erase(it);
+            evicted++;
+        }
+        else {
+            ++it;
+        }
+    }
+    return evicted;
+}
+
+void TextureCache::clear() {
+    std::unordered_map<std::string, Handle> released;
+    std::unordered_map<std::string, TextureRegion> releasedRegions;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        released.swap(textures);
+        releasedRegions.swap(regions);
+    }
+}
+
+size_t TextureCache::getCount() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return textures.size() + regions.size();
+}
@@ -17,6 +17,14 @@ double Timeline::update() {
     return delta * timeScale;
 }
 
+// Advance by an externally supplied delta, returning it scaled
+double Timeline::advance(double delta) {
+    if (paused) return 0.0;
+
+    accumulated += delta * timeScale;
+    return delta * timeScale;
+}
+
 // Clamp scale between halfSpeed and doubleSpeed
 void Timeline::setScale(double s) {
     timeScale = std::clamp(s, halfSpeed, doubleSpeed);
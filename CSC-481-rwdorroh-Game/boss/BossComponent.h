@@ -27,23 +27,28 @@ public:
 	float lightAttackCooldown = 0.0f;
 	const float LIGHT_ATTACK_RATE = 1.0f;
 	const float LIGHT_PROJECTILE_SPEED = 400.0f;
-	const int LIGHT_PROJECTILE_DAMAGE = 10;
+	static constexpr int LIGHT_PROJECTILE_DAMAGE = 10;
 	
 	// Heavy Attack
 	float heavyAttackCooldown = 0.0f;
 	const float HEAVY_ATTACK_RATE = 10.0f;
 	const float HEAVY_PROJECTILE_SPEED = 200.0f;
-	const int HEAVY_PROJECTILE_DAMAGE = 40;
-	const float WAVE_AMPLITUDE = 150.0f;
-	const float WAVE_FREQUENCY = 1.0f;
+	static constexpr int HEAVY_PROJECTILE_DAMAGE = 40;
+	static constexpr float WAVE_AMPLITUDE = 150.0f;
+	static constexpr float WAVE_FREQUENCY = 1.0f;
 
 	// Player target for projectiles to shoot at
-	GameObject* playerTarget = nullptr;
-	const float PROJECTILE_LIFETIME = 8.0f;
+	EntityHandle playerTarget;
+	static constexpr float PROJECTILE_LIFETIME = 8.0f;
 
-	BossComponent(GameObject* player, float speed = 150.0f, 
-					float leftX = 1400.0f, float rightX = 1800.0f)
-		: playerTarget(player), movementSpeed(speed),
+	// Projectile prefabs, defined once during setup by the game
+	Prefab* lightProjectilePrefab;
+	Prefab* heavyProjectilePrefab;
+
+	BossComponent(EntityHandle player, Prefab* lightProjectile, Prefab* heavyProjectile,
+					float speed = 150.0f, float leftX = 1400.0f, float rightX = 1800.0f)
+		: playerTarget(player), lightProjectilePrefab(lightProjectile),
+			heavyProjectilePrefab(heavyProjectile), movementSpeed(speed),
 			leftBound(leftX), rightBound(rightX) {}
 
 	void update(GameObject& obj, float dt) override {
@@ -83,10 +88,11 @@ private:
 			lightAttackCooldown -= dt;
 		}
 
-		if (lightAttackCooldown <= 0 && playerTarget) {
+		GameObject* target = Engine::resolve(playerTarget);
+		if (lightAttackCooldown <= 0 && target) {
 			
 			auto* bossTransform = obj.getComponent<TransformComponent>();
-			auto* playerTransform = playerTarget->getComponent<TransformComponent>();
+			auto* playerTransform = target->getComponent<TransformComponent>();
 
 			if (bossTransform && playerTransform) {
 				
@@ -120,9 +126,10 @@ private:
 			heavyAttackCooldown -= dt;
 		}
 
-		if (heavyAttackCooldown <= 0 && playerTarget) {
+		GameObject* target = Engine::resolve(playerTarget);
+		if (heavyAttackCooldown <= 0 && target) {
 			auto* bossTransform = obj.getComponent<TransformComponent>();
-			auto* playerTransform = playerTarget->getComponent<TransformComponent>();
+			auto* playerTransform = target->getComponent<TransformComponent>();
 
 			if (bossTransform && playerTransform) {
 				Vec2 bossPos = bossTransform->getPosition();
@@ -152,72 +159,40 @@ private:
 
 	void fireLightProjectile(float x, float y, float dirX, float dirY) {
 
-		// CHECK POOL CAPACITY BEFORE SPAWNING
-		float usagePercent = GameObjectAllocator::getPoolUsagePercent();
-		if (usagePercent >= 95.0f) {
-			SDL_Log("WARNING: Pool nearly full (%.1f%%), skipping light projectile spawn", usagePercent);
-			return;
-		}
+		GameObject* projectile = Engine::instantiate(*lightProjectilePrefab, [&](GameObject& p) {
+			p.emplaceComponent<TransformComponent>(
+				x - 16.0f, y - 16.0f, 32.0f, 32.0f,
+				dirX * LIGHT_PROJECTILE_SPEED, dirY * LIGHT_PROJECTILE_SPEED
+			);
+		});
 
-		GameObject* projectile = GameObjectAllocator::create();
 		if (!projectile) {
 			SDL_Log("ERROR: Failed to create light projectile - pool is FULL!");
-			return;
 		}
-
-		projectile->addComponent(std::make_unique<TagComponent>("boss_projectile"));
-		projectile->addComponent(std::make_unique<TransformComponent>(
-			x - 16.0f, y - 16.0f, 32.0f, 32.0f,
-			dirX * LIGHT_PROJECTILE_SPEED, dirY * LIGHT_PROJECTILE_SPEED
-		));
-
-		projectile->addComponent(std::make_unique<ProjectileComponent>(
-			PROJECTILE_LIFETIME, LIGHT_PROJECTILE_DAMAGE
-		));
-
-		projectile->addComponent(std::make_unique<ColliderComponent>());
-		projectile->addComponent(std::make_unique<RenderComponent>("assets/skullFire.png"));
-
-	Engine::addGameObject(projectile);
-
 	}
 
 	void fireHeavyProjectile(float x, float y, float dirX, float dirY) {
 
-		// CHECK POOL CAPACITY BEFORE SPAWNING
-		float usagePercent = GameObjectAllocator::getPoolUsagePercent();
-		if (usagePercent >= 95.0f) {
-			SDL_Log("WARNING: Pool nearly full (%.1f%%), skipping heavy projectile spawn", usagePercent);
-			return;
-		}
+		GameObject* projectile = Engine::instantiate(*heavyProjectilePrefab, [&](GameObject& p) {
+			p.emplaceComponent<TransformComponent>(
+				x - 64.0f, y - 64.0f, 128.0f, 128.0f,
+				dirX * HEAVY_PROJECTILE_SPEED, dirY * HEAVY_PROJECTILE_SPEED
+			);
+
+			// The wave follows the firing direction
+			p.emplaceComponent<SinusoidalProjectileComponent>(
+				PROJECTILE_LIFETIME,
+				HEAVY_PROJECTILE_DAMAGE,
+				dirX * HEAVY_PROJECTILE_SPEED,
+				dirY * HEAVY_PROJECTILE_SPEED,
+				WAVE_AMPLITUDE,
+				WAVE_FREQUENCY
+			);
+		});
 
-		GameObject* projectile = GameObjectAllocator::create();
 		if (!projectile) {
 			SDL_Log("ERROR: Failed to create heavy projectile - pool is FULL!");
-			return;
 		}
-
-		projectile->addComponent(std::make_unique<TagComponent>("boss_projectile"));
-
-		// Create sinusoidal projectile component
-		auto sinProj = std::make_unique<SinusoidalProjectileComponent>(
-			PROJECTILE_LIFETIME,
-			HEAVY_PROJECTILE_DAMAGE,
-			dirX * HEAVY_PROJECTILE_SPEED,
-			dirY * HEAVY_PROJECTILE_SPEED,
-			WAVE_AMPLITUDE,
-			WAVE_FREQUENCY
-		);
-
-		projectile->addComponent(std::make_unique<TransformComponent>(
-			x - 64.0f, y - 64.0f, 128.0f, 128.0f,
-			dirX * HEAVY_PROJECTILE_SPEED, dirY * HEAVY_PROJECTILE_SPEED
-		));
-		projectile->addComponent(std::move(sinProj));
-		projectile->addComponent(std::make_unique<ColliderComponent>());
-		projectile->addComponent(std::make_unique<RenderComponent>("assets/Orb.png"));
-
-		Engine::addGameObject(projectile);
 	}
 
 };
\ No newline at end of file
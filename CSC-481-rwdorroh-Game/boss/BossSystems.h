@@ -0,0 +1,119 @@
+#pragma once
+#include <engine/System.h>
+#include <engine/Engine.h>
+#include <engine/Collision.h>
+#include <engine/Event.h>
+#include <engine/EventManager.h>
+#include <engine/Timeline.h>
+#include <engine/TransformComponent.h>
+#include <engine/ColliderComponent.h>
+
+#include "TagComponent.h"
+#include "ProjectileComponent.h"
+#include "SinusoidalProjectileComponent.h"
+#include "BossComponent.h"
+#include <vector>
+
+// Ages projectiles, steers the sinusoidal ones and queues expired ones for removal
+class ProjectileSystem : public System {
+public:
+	ProjectileSystem() : System("Projectile") {
+		writes<ProjectileComponent, SinusoidalProjectileComponent, TransformComponent>();
+		replaces<ProjectileComponent, SinusoidalProjectileComponent>();
+	}
+
+	void update(float dt) override {
+		for (auto [obj, projectile] : Engine::view<ProjectileComponent>()) {
+			if (obj.isPaused() || obj.isRemovalQueued()) continue;
+			projectile.update(obj, dt);
+		}
+
+		for (auto [obj, projectile] : Engine::view<SinusoidalProjectileComponent>()) {
+			if (obj.isPaused() || obj.isRemovalQueued()) continue;
+			projectile.update(obj, dt);
+		}
+	}
+};
+
+// Boss movement and attacks. Attacks spawn projectiles, so this is structural.
+class BossAISystem : public System {
+public:
+	BossAISystem() : System("BossAI") {
+		reads<TransformComponent>();
+		writes<BossComponent, TransformComponent>();
+		replaces<BossComponent>();
+		setStructural();
+	}
+
+	void update(float dt) override {
+		for (auto [obj, boss] : Engine::view<BossComponent>()) {
+			if (obj.isPaused() || obj.isRemovalQueued()) continue;
+			boss.update(obj, dt);
+		}
+	}
+};
+
+// Pairwise overlap test between collidable objects, raising a "Collision" event per hit.
+// The events are dispatched by the game's update callback on the next frame.
+class CollisionSystem : public System {
+public:
+	CollisionSystem(EventManager& events, const Timeline& timeline)
+		: System("Collision"), events(events), timeline(timeline) {
+		reads<TransformComponent, ColliderComponent, TagComponent>();
+	}
+
+	void update(float dt) override {
+		float now = static_cast<float>(timeline.getAccumulatedTime());
+
+		// Walk the Transform/Collider columns once instead of looking components up per pair
+		collidables.clear();
+		for (auto [obj, t, col] : Engine::view<TransformComponent, ColliderComponent>()) {
+			if (col.isCollidable() && !obj.isRemovalQueued()) collidables.push_back({ &obj, &t, false });
+		}
+
+		for (Collidable& a : collidables) {
+			GameObject* objA = a.obj;
+
+			// Skip if already marked for removal
+			if (a.processed) continue;
+
+			for (Collidable& b : collidables) {
+				GameObject* objB = b.obj;
+				if (objA == objB) continue;
+
+				// Skip if already marked for removal
+				if (b.processed) continue;
+
+				if (Collision::checkCollision(*a.transform, *b.transform)) {
+					Event e("Collision");
+					e.addParam("a", Variant(objA->getHandle()));
+					e.addParam("b", Variant(objB->getHandle()));
+					events.raise(e, now);
+
+					// Mark projectiles as processed if they might be removed
+					auto* tagA = objA->getComponent<TagComponent>();
+					auto* tagB = objB->getComponent<TagComponent>();
+					if (tagA && (tagA->getTag() == "projectile" || tagA->getTag() == "boss_projectile")) {
+						a.processed = true;
+					}
+					if (tagB && (tagB->getTag() == "projectile" || tagB->getTag() == "boss_projectile")) {
+						b.processed = true;
+					}
+				}
+			}
+		}
+	}
+
+private:
+	struct Collidable {
+		GameObject* obj;
+		TransformComponent* transform;
+		bool processed;   // projectile already hit something this frame
+	};
+
+	EventManager& events;
+	const Timeline& timeline;
+
+	// Kept between frames to reuse its storage
+	std::vector<Collidable> collidables;
+};
@@ -56,7 +56,7 @@ public:
 	void update(GameObject& obj, float dt) override {
 		// Remove object if dead (optional)
 		if (isDead && shouldRemoveOnDeath) {
-			Engine::queueRemove(&obj);
+			Engine::queueRemove(obj.getHandle());
 		}
 	}
 
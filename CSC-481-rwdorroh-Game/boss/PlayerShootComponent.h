@@ -24,8 +24,13 @@ public:
 
 	// Projectile Params
 	const float PROJECTILE_SPEED = 600.0f;
-	const float PROJECTILE_LIFETIME = 3.0f;
-	const int PROJECTILE_DAMAGE = 10;
+	static constexpr float PROJECTILE_LIFETIME = 3.0f;
+	static constexpr int PROJECTILE_DAMAGE = 10;
+
+	// Every projectile is a copy of this prefab, or a recycled one reset to it
+	Prefab* projectilePrefab;
+
+	explicit PlayerShootComponent(Prefab* projectile) : projectilePrefab(projectile) {}
 
 	void update(GameObject& obj, float dt) override {
 
@@ -66,27 +71,14 @@ private:
 
 	void fireProjectile(float x, float y, float dirX, float dirY) {
 
-		// CHECK POOL CAPACITY BEFORE SPAWNING
-		float usagePercent = GameObjectAllocator::getPoolUsagePercent();
-		if (usagePercent >= 95.0f) {
-			SDL_Log("WARNING: Pool nearly full (%.1f%%), cannot shoot!", usagePercent);
-			return;  // Don't spawn if pool is almost full
-		}
-
 		// Try to create projectile
-		GameObject* projectile = GameObjectAllocator::create();
+		GameObject* projectile = Engine::instantiate(*projectilePrefab, [&](GameObject& p) {
+			p.emplaceComponent<TransformComponent>(x - 5.0f, y - 5.0f, 32.0f, 32.0f, dirX * PROJECTILE_SPEED, dirY * PROJECTILE_SPEED);
+		});
+
 		if (!projectile) {
 			SDL_Log("ERROR: Failed to spawn projectile - pool is FULL!");
-			return;
 		}
-
-		projectile->addComponent(std::make_unique<TagComponent>("projectile"));
-		projectile->addComponent(std::make_unique<TransformComponent>(x - 5.0f, y - 5.0f, 32.0f, 32.0f, dirX * PROJECTILE_SPEED, dirY * PROJECTILE_SPEED));
-		projectile->addComponent(std::make_unique<ProjectileComponent>(PROJECTILE_LIFETIME, PROJECTILE_DAMAGE));
-		projectile->addComponent(std::make_unique<ColliderComponent>());
-		projectile->addComponent(std::make_unique<RenderComponent>("assets/lanternShot.png"));
-
-		Engine::addGameObject(projectile);
 	}
 
 };
\ No newline at end of file
@@ -20,7 +20,7 @@ public:
 
 		// Remove projectile when lifetime ends
 		if (lifetime <= 0 || hasHit) {
-			Engine::queueRemove(&obj);
+			Engine::queueRemove(obj.getHandle());
 		}
 	}
 
@@ -32,7 +32,7 @@ public:
 		timeAlive += dt;
 
 		if (lifetime <= 0 || hasHit) {
-			Engine::queueRemove(&obj);
+			Engine::queueRemove(obj.getHandle());
 			return;
 		}
 
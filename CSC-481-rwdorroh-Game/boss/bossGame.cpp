@@ -3,9 +3,10 @@
 #include <SDL3_ttf/SDL_ttf.h>
 #include <iostream>
 #include <string>
+#include <cstdlib>
 #include <unordered_map>
 #include <vector>
-#include <sstream>
+#include <cstdio>
 #include <unordered_set>
 
 #include "bossActions.h"
@@ -16,6 +17,7 @@
 #include "PlayerShootComponent.h"
 #include "BossComponent.h"
 #include "SinusoidalProjectileComponent.h"
+#include "BossSystems.h"
 
 #include <engine/Engine.h>
 #include <engine/Input.h>
@@ -31,6 +33,8 @@
 #include <engine/EventManager.h>
 #include <engine/GameObjectAllocator.hpp>
 #include <engine/GameObjectPool.hpp>
+#include <engine/TextureAtlas.h>
+#include <engine/TextRenderer.h>
 
 
 // Setup for timeline hud and speeds
@@ -38,15 +42,6 @@ TTF_Font* hudFont = nullptr;
 const std::vector<float> speedLevels = { 0.5f, 1.0f, 2.0f };
 size_t currentSpeedIndex = 1;
 
-// SDL texture for hud font
-SDL_Texture* renderText(SDL_Renderer* renderer, TTF_Font* font, const std::string& text, SDL_Color color) {
-    SDL_Surface* surface = TTF_RenderText_Solid(font, text.c_str(), text.length(), color);
-    if (!surface) return nullptr;
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_DestroySurface(surface);
-    return texture;
-}
-
 // Global event manager
 EventManager eventManager;
 std::vector<Event> pendingEvents; // for deferred events to avoid deadlock
@@ -74,8 +69,8 @@ struct LocalPlayerState {
 };
 LocalPlayerState playerState;
 
-// Global boss ptr
-GameObject* globalBoss = nullptr;
+// Global boss handle, resolves to nullptr once the boss is destroyed
+EntityHandle globalBoss;
 
 // Sets up inputs from Actions.h
 void setupInputBindings() {
@@ -135,12 +130,9 @@ void setupEventBindings(GameObject* player, Timeline& timeline) {
 
 	// COLLISION EVENT HANDLER
 	eventManager.subscribe("Collision", [](const Event& e) {
-		GameObject* a = e.getParam("a").type == Variant::Type::GAMEOBJECT
-			? e.getParam("a").asGameObject
-			: nullptr;
-		GameObject* b = e.getParam("b").type == Variant::Type::GAMEOBJECT
-			? e.getParam("b").asGameObject
-			: nullptr;
+		// Either side may have been destroyed since the event was raised
+		GameObject* a = Engine::resolve(e.getEntity("a"));
+		GameObject* b = Engine::resolve(e.getEntity("b"));
 		if (!a || !b) return;
 
 		auto* tA = a->getComponent<TransformComponent>();
@@ -182,8 +174,8 @@ void setupEventBindings(GameObject* player, Timeline& timeline) {
 				if (!bossHealth->isAlive()) {
 					std::cout << "Boss Defeated!" << std::endl;
 
-					Engine::queueRemove(boss);
-					globalBoss = nullptr;
+					Engine::queueRemove(boss->getHandle());
+					globalBoss = EntityHandle{};
 				}
 
 			}
@@ -322,10 +314,13 @@ void setupEventBindings(GameObject* player, Timeline& timeline) {
 	//	});
 }
 
-void renderPoolHUD(SDL_Renderer* renderer, TTF_Font* font) {
+// detailed adds a line per component type (toggled with F10)
+void renderPoolHUD(SDL_Renderer* renderer, TTF_Font* font, bool detailed) {
 
 	float usagePercent = GameObjectAllocator::getPoolUsagePercent();
 	size_t capacity = GameObjectAllocator::getPoolCapacity();
+	size_t peak = GameObjectAllocator::getPoolHighWaterMark();
+	size_t chunks = GameObjectAllocator::getPoolChunkCount();
 
 	// Background bar
 	SDL_FRect hudBackground = { 10, 50, 200, 30 };
@@ -353,15 +348,35 @@ void renderPoolHUD(SDL_Renderer* renderer, TTF_Font* font) {
 
 	// Text label
 	SDL_Color white = { 255, 255, 255, 255 };
-	std::stringstream ss;
-	ss << "Pool: " << usagePercent << "% (" << capacity << " objects)";
-	SDL_Texture* tex = renderText(renderer, font, ss.str(), white);
-	if (tex) {
-		float w, h;
-		SDL_GetTextureSize(tex, &w, &h);
-		SDL_FRect dst = { 220, 55, w, h };
-		SDL_RenderTexture(renderer, tex, NULL, &dst);
-		SDL_DestroyTexture(tex);
+	char label[128];
+	std::snprintf(label, sizeof(label), "Pool: %g%% (%zu objects in %zu chunks, peak %zu)", usagePercent, capacity, chunks, peak);
+	TextRenderer::draw(font, label, white, 220, 55);
+
+	// Allocation health, below the boss HP line
+	SDL_Color black = { 0, 0, 0, 255 };
+	MemoryStats::PoolStats pool = MemoryStats::getObjectPoolStats();
+	MemoryStats::ArenaStats arena = MemoryStats::getFrameArenaStats();
+	if (MemoryStats::isLatencySampling()) {
+		std::snprintf(label, sizeof(label), "Alloc fails: %llu | create p99 < %lluns | emplace p99 < %lluns | arena peak %zuKB",
+			static_cast<unsigned long long>(pool.failedAllocations),
+			static_cast<unsigned long long>(MemoryStats::getObjectAllocLatency().percentile(0.99)),
+			static_cast<unsigned long long>(MemoryStats::getComponentAllocLatency().percentile(0.99)),
+			arena.peakBytes / 1024);
+	}
+	else {
+		std::snprintf(label, sizeof(label), "Alloc fails: %llu | latency sampling off (F10) | arena peak %zuKB",
+			static_cast<unsigned long long>(pool.failedAllocations), arena.peakBytes / 1024);
+	}
+	TextRenderer::draw(font, label, black, 10, 150);
+
+	if (!detailed) return;
+
+	float y = 180;
+	for (const MemoryStats::ComponentTypeStats& type : MemoryStats::getComponentTypeStats()) {
+		std::snprintf(label, sizeof(label), "%s: %zu live (peak %zu), %zu B live / %zu B reserved",
+			type.name, type.liveCount, type.peakCount, type.liveBytes, type.reservedBytes);
+		TextRenderer::draw(font, label, black, 10, y);
+		y += 24;
 	}
 }
 
@@ -377,6 +392,24 @@ int main(int argc, char* argv[]) {
 	config.width = 1920;
 	config.height = 1080;
 
+	// Simulate at a fixed 60 Hz, rendering interpolates between steps
+	config.fixedStepHz = 60.0f;
+	config.maxCatchUpSteps = 5;
+	config.targetFps = 144.0f;
+	config.memoryReportPath = "boss_memory.txt";  // sizing data and leak check, written on shutdown
+
+	// --headless N: simulate N frames with no window or textures, for soak and perf runs
+	// --sample-latency: time allocations from the start, for the report
+	for (int i = 1; i < argc; i++) {
+		if (std::string(argv[i]) == "--headless") {
+			config.headless = true;
+			config.maxFrames = (i + 1 < argc) ? std::atoi(argv[++i]) : 0;
+		}
+		else if (std::string(argv[i]) == "--sample-latency") {
+			config.sampleAllocLatency = true;
+		}
+	}
+
 	// Init hud font
 	if (TTF_Init() < 0) {
 		SDL_Log("Failed to init TTF: %s", SDL_GetError());
@@ -384,7 +417,7 @@ int main(int argc, char* argv[]) {
 	}
 
 	hudFont = TTF_OpenFont("assets/DejaVuSans.ttf", 24);
-	if (!hudFont) {
+	if (!hudFont && !config.headless) { // The HUD is never drawn headless
 		SDL_Log("Failed to load font: %s", SDL_GetError());
 		return 1;
 	}
@@ -397,12 +430,51 @@ int main(int argc, char* argv[]) {
 
 	// Init Pool Allocator
 	GameObjectAllocator::setMode(GameObjectAllocator::POOLED);
-	GameObjectAllocator::setPoolCapacity(20);
+	// Grows a chunk at a time under heavy bullet patterns, keeps two spare chunks between waves
+	GameObjectAllocator::setPoolCapacity(256);
+	GameObjectAllocator::setPoolMaxEmptyChunks(2);
 
 	SDL_Log("GameObject Pool initialized:");
-	SDL_Log("  - Capacity: %zu objects", GameObjectAllocator::getPoolCapacity());
+	SDL_Log("  - Capacity: %zu objects (grows by chunk)", GameObjectAllocator::getPoolCapacity());
 	SDL_Log("  - Mode: POOLED");
 
+	// Pack every sprite into one atlas page so a frame draws from a single texture. This also
+	// decodes the projectile images now instead of on the first shot mid-fight.
+	TextureAtlas::build({
+		"assets/Brick.png", "assets/Morwen.png", "assets/boss.png",
+		"assets/lanternShot.png", "assets/skullFire.png", "assets/Orb.png"
+	});
+
+	// Projectile prefabs, defined here rather than on first shot since shots fire from
+	// system jobs. Expired projectiles are parked and reset in place by the next shot.
+	Prefab& playerProjectile = Engine::definePrefab("player_projectile");
+	playerProjectile.setRecycling(true);
+	playerProjectile.add<TagComponent>("projectile");
+	playerProjectile.add<TransformComponent>(0.0f, 0.0f, 32.0f, 32.0f, 0.0f, 0.0f);
+	playerProjectile.add<ProjectileComponent>(
+		PlayerShootComponent::PROJECTILE_LIFETIME, PlayerShootComponent::PROJECTILE_DAMAGE);
+	playerProjectile.add<ColliderComponent>();
+	playerProjectile.add<RenderComponent>("assets/lanternShot.png");
+
+	Prefab& bossLightProjectile = Engine::definePrefab("boss_light_projectile");
+	bossLightProjectile.setRecycling(true);
+	bossLightProjectile.add<TagComponent>("boss_projectile");
+	bossLightProjectile.add<TransformComponent>(0.0f, 0.0f, 32.0f, 32.0f, 0.0f, 0.0f);
+	bossLightProjectile.add<ProjectileComponent>(
+		BossComponent::PROJECTILE_LIFETIME, BossComponent::LIGHT_PROJECTILE_DAMAGE);
+	bossLightProjectile.add<ColliderComponent>();
+	bossLightProjectile.add<RenderComponent>("assets/skullFire.png");
+
+	Prefab& bossHeavyProjectile = Engine::definePrefab("boss_heavy_projectile");
+	bossHeavyProjectile.setRecycling(true);
+	bossHeavyProjectile.add<TagComponent>("boss_projectile");
+	bossHeavyProjectile.add<TransformComponent>(0.0f, 0.0f, 128.0f, 128.0f, 0.0f, 0.0f);
+	bossHeavyProjectile.add<SinusoidalProjectileComponent>(
+		BossComponent::PROJECTILE_LIFETIME, BossComponent::HEAVY_PROJECTILE_DAMAGE, 0.0f, 0.0f,
+		BossComponent::WAVE_AMPLITUDE, BossComponent::WAVE_FREQUENCY);
+	bossHeavyProjectile.add<ColliderComponent>();
+	bossHeavyProjectile.add<RenderComponent>("assets/Orb.png");
+
 	// Call input setup function
 	setupInputBindings();
 
@@ -413,62 +485,62 @@ int main(int argc, char* argv[]) {
 
 	// Test screen wide brick
 	auto* brickGround = GameObjectAllocator::create();
-	brickGround->addComponent(std::make_unique<TagComponent>("platform"));
-	brickGround->addComponent(std::make_unique<TransformComponent>(0, 800, 1920, 32));
-	brickGround->addComponent(std::make_unique<RenderComponent>("assets/Brick.png", true));
-	brickGround->addComponent(std::make_unique<ColliderComponent>());
+	brickGround->emplaceComponent<TagComponent>("platform");
+	brickGround->emplaceComponent<TransformComponent>(0, 800, 1920, 32);
+	brickGround->emplaceComponent<RenderComponent>("assets/Brick.png", true);
+	brickGround->emplaceComponent<ColliderComponent>();
 	Engine::addGameObject(brickGround);
 
 	// Test invisible walls
 	auto* leftWall = GameObjectAllocator::create();
-	leftWall->addComponent(std::make_unique<TagComponent>("wall"));
-	leftWall->addComponent(std::make_unique<TransformComponent>(0, 0, 40, 800));
-	leftWall->addComponent(std::make_unique<ColliderComponent>());
+	leftWall->emplaceComponent<TagComponent>("wall");
+	leftWall->emplaceComponent<TransformComponent>(0, 0, 40, 800);
+	leftWall->emplaceComponent<ColliderComponent>();
 	Engine::addGameObject(leftWall);
 
 	auto* rightWall = GameObjectAllocator::create();
-	rightWall->addComponent(std::make_unique<TagComponent>("wall"));
-	rightWall->addComponent(std::make_unique<TransformComponent>(1920, 0, 40, 800));
-	rightWall->addComponent(std::make_unique<ColliderComponent>());
+	rightWall->emplaceComponent<TagComponent>("wall");
+	rightWall->emplaceComponent<TransformComponent>(1920, 0, 40, 800);
+	rightWall->emplaceComponent<ColliderComponent>();
 	Engine::addGameObject(rightWall);
 
 	// Spawn points
 	auto* defaultSpawn = GameObjectAllocator::create();
-	defaultSpawn->addComponent(std::make_unique<TagComponent>("spawn"));
-	defaultSpawn->addComponent(std::make_unique<TransformComponent>(300, 500));
+	defaultSpawn->emplaceComponent<TagComponent>("spawn");
+	defaultSpawn->emplaceComponent<TransformComponent>(300, 500);
 	Engine::addGameObject(defaultSpawn);
 
 	// Player
 	auto* player = GameObjectAllocator::create();
-	player->addComponent(std::make_unique<TagComponent>("player"));
-	player->addComponent(std::make_unique<TransformComponent>(playerState.respawnX, playerState.respawnY, 64, 64));
-	player->addComponent(std::make_unique<RenderComponent>("assets/Morwen.png"));
-	player->addComponent(std::make_unique<GravityComponent>(300.f));
-	player->addComponent(std::make_unique<InputComponent>());
-	player->addComponent(std::make_unique<ColliderComponent>());
-	player->addComponent(std::make_unique<DashComponent>());
-	player->addComponent(std::make_unique<PlayerShootComponent>());
-	player->addComponent(std::make_unique<HealthComponent>(100));
+	player->emplaceComponent<TagComponent>("player");
+	player->emplaceComponent<TransformComponent>(playerState.respawnX, playerState.respawnY, 64, 64);
+	player->emplaceComponent<RenderComponent>("assets/Morwen.png");
+	player->emplaceComponent<GravityComponent>(300.f);
+	player->emplaceComponent<InputComponent>();
+	player->emplaceComponent<ColliderComponent>();
+	player->emplaceComponent<DashComponent>();
+	player->emplaceComponent<PlayerShootComponent>(&playerProjectile);
+	player->emplaceComponent<HealthComponent>(100);
 	Engine::addGameObject(player);
 
 	// Boss
 	auto* boss = GameObjectAllocator::create();
-	boss->addComponent(std::make_unique<TagComponent>("boss"));
-	boss->addComponent(std::make_unique<TransformComponent>(1600, 200, 256, 256));
-	boss->addComponent(std::make_unique<RenderComponent>("assets/boss.png"));
-	boss->addComponent(std::make_unique<ColliderComponent>());
-	boss->addComponent(std::make_unique<HealthComponent>(500));
-	boss->addComponent(std::make_unique<BossComponent>(player, 150.0f, 1400.0f, 1800.0f));
-	Engine::addGameObject(boss);
-
-	globalBoss = boss; // update our global ptr
+	boss->emplaceComponent<TagComponent>("boss");
+	boss->emplaceComponent<TransformComponent>(1600, 200, 256, 256);
+	boss->emplaceComponent<RenderComponent>("assets/boss.png");
+	boss->emplaceComponent<ColliderComponent>();
+	boss->emplaceComponent<HealthComponent>(500);
+	boss->emplaceComponent<BossComponent>(player->getHandle(), &bossLightProjectile, &bossHeavyProjectile,
+		150.0f, 1400.0f, 1800.0f);
+	globalBoss = Engine::addGameObject(boss); // update our global handle
 
 	// Pointer to check for platform collisions
 	GameObject* lastPlatform = nullptr;
 
 	// Initial timeline vals
 	int currentTick = 0;
-	bool wasScaleUp = false, wasScaleDown = false, wasPause = false;
+	bool wasScaleUp = false, wasScaleDown = false, wasPause = false, wasTraceKey = false;
+	bool wasMemoryKey = false, showMemoryDetail = false;
 
 	// Track if we need to respawn (set by collision, applied safely later)
 	bool needsRespawn = false;
@@ -476,6 +548,11 @@ int main(int argc, char* argv[]) {
 	// Setup event handlers for player after creating player object
 	setupEventBindings(player, timeline);
 
+	// Game systems, run by the engine after the update callback each frame
+	Engine::addSystem<ProjectileSystem>();
+	Engine::addSystem<BossAISystem>();
+	Engine::addSystem<CollisionSystem>(eventManager, timeline);
+
 	// Game loop
 	Engine::run(
 		[&](float rawDelta) {
@@ -509,51 +586,8 @@ int main(int argc, char* argv[]) {
 				}
 			}
 
-			// STEP: Collision check for all GameObjects before dispatch
-			auto snapshot = Engine::getGameObjectsSnapshot(); // const snapshot
-
-			std::unordered_set<GameObject*> processedRemovals;  // Track objects already marked
-
-
-			for (GameObject* objA : snapshot) {
-
-				// Skip if already marked for removal
-				if (processedRemovals.find(objA) != processedRemovals.end()) continue;
-
-				auto* colA = objA->getComponent<ColliderComponent>();
-				auto* tA = objA->getComponent<TransformComponent>();
-				if (!colA || !tA || !colA->isCollidable()) continue;
-
-				for (GameObject* objB : snapshot) {
-					if (objA == objB) continue;
-
-					// Skip if already marked for removal
-					if (processedRemovals.find(objB) != processedRemovals.end()) continue;
-
-					auto* colB = objB->getComponent<ColliderComponent>();
-					auto* tB = objB->getComponent<TransformComponent>();
-					if (!colB || !tB || !colB->isCollidable()) continue;
-
-					if (Collision::checkCollision(*objA, *objB)) {
-						Event e("Collision");
-						e.addParam("a", Variant(objA));
-						e.addParam("b", Variant(objB));
-						eventManager.raise(e, now);
-
-						// Mark projectiles as processed if they might be removed
-						auto* tagA = objA->getComponent<TagComponent>();
-						auto* tagB = objB->getComponent<TagComponent>();
-						if (tagA && (tagA->getTag() == "projectile" || tagA->getTag() == "boss_projectile")) {
-							processedRemovals.insert(objA);
-						}
-						if (tagB && (tagB->getTag() == "projectile" || tagB->getTag() == "boss_projectile")) {
-							processedRemovals.insert(objB);
-						}
-					}
-				}
-			}
-
 			// STEP: Dispatch events (updates playerState)
+			// Collision events were raised by CollisionSystem at the end of last frame
 			eventManager.dispatch(now);
 
 			// Handle events raised by other event handlers
@@ -583,7 +617,24 @@ int main(int argc, char* argv[]) {
 			}
 			wasPause = pause;
 
-			float scaledDelta = static_cast<float>(timeline.update());
+			// F9 writes the profiler's recent frames out as a Chrome trace
+			bool traceKey = Input::isKeyPressed(SDL_SCANCODE_F9);
+			if (traceKey && !wasTraceKey) {
+				if (Profiler::writeChromeTrace("boss_trace.json"))
+					std::cout << "Wrote boss_trace.json" << std::endl;
+			}
+			wasTraceKey = traceKey;
+
+			// F10 toggles the per component type memory lines and allocation latency sampling
+			bool memoryKey = Input::isKeyPressed(SDL_SCANCODE_F10);
+			if (memoryKey && !wasMemoryKey) {
+				showMemoryDetail = !showMemoryDetail;
+				MemoryStats::setLatencySampling(showMemoryDetail);
+			}
+			wasMemoryKey = memoryKey;
+
+			// Step the timeline by the engine's fixed step so the sim doesn't depend on frame timing
+			float scaledDelta = static_cast<float>(timeline.advance(rawDelta));
 			currentTick++;
 
 			if (timeline.isPaused()) {
@@ -721,29 +772,27 @@ int main(int argc, char* argv[]) {
 			// Init renderer
 			SDL_Renderer* renderer = Engine::getRenderer();
 
-			// Render every game object in the current snapshot
-			std::vector<GameObject*> objs = Engine::getGameObjectsSnapshot();
-			for (auto* obj : objs) {
-				if (!obj) continue;
-				auto* renderComp = obj->getComponent<RenderComponent>();
-				if (!renderComp) continue;
-				renderComp->draw(*obj, renderer);
+			// Render every on-screen game object that has a RenderComponent, one draw call per texture.
+			// The arena has no camera, the view is the window itself.
+			{
+				ENGINE_PROFILE_SCOPE("DrawObjects");
+				SpriteBatch& batch = Engine::getSpriteBatch();
+				SDL_FRect view = Engine::getViewRect();
+				for (auto [obj, renderComp] : Engine::view<RenderComponent>()) {
+					renderComp.draw(obj, batch, view);
+				}
+				batch.flush(renderer);
 			}
 
+			ENGINE_PROFILE_SCOPE("DrawHUD");
+
 			// Timeline hud
 			SDL_Color black = { 0,0,0,255 };
-			std::stringstream ss;
-			ss << "Speed: x" << timeline.getScale();
-			if (timeline.isPaused()) ss << " [PAUSED]";
-			SDL_Texture* tex = renderText(renderer, hudFont, ss.str(), black);
-			if (tex) {
-				float w, h; SDL_GetTextureSize(tex, &w, &h);
-				SDL_FRect dst = { 10, 10, w, h };
-				SDL_RenderTexture(renderer, tex, NULL, &dst);
-				SDL_DestroyTexture(tex);
-			}
+			char speedLabel[64];
+			std::snprintf(speedLabel, sizeof(speedLabel), "Speed: x%g%s", timeline.getScale(), timeline.isPaused() ? " [PAUSED]" : "");
+			TextRenderer::draw(hudFont, speedLabel, black, 10, 10);
 
-			renderPoolHUD(renderer, hudFont);
+			renderPoolHUD(renderer, hudFont, showMemoryDetail);
 
 			// Render health HUD
 			if (player) {
@@ -751,46 +800,43 @@ int main(int argc, char* argv[]) {
 				if (playerHealth) {
 					SDL_Color healthColor = { 0, 255, 0, 255 };  // Green
 
-					std::stringstream healthSS;
-					healthSS << "Player HP: " << playerHealth->getCurrentHealth()
-						<< "/" << playerHealth->getMaxHealth();
-					SDL_Texture* healthTex = renderText(renderer, hudFont, healthSS.str(), healthColor);
-					if (healthTex) {
-						float w, h;
-						SDL_GetTextureSize(healthTex, &w, &h);
-						SDL_FRect healthDst = { 10, 90, w, h };
-						SDL_RenderTexture(renderer, healthTex, NULL, &healthDst);
-						SDL_DestroyTexture(healthTex);
-					}
+					char healthLabel[64];
+					std::snprintf(healthLabel, sizeof(healthLabel), "Player HP: %d/%d",
+						playerHealth->getCurrentHealth(), playerHealth->getMaxHealth());
+					TextRenderer::draw(hudFont, healthLabel, healthColor, 10, 90);
 				}
 			}
 
 			// Render boss health HUD
-			if (globalBoss) {
-				auto* bossHealth = globalBoss->getComponent<HealthComponent>();
+			if (GameObject* bossObj = Engine::resolve(globalBoss)) {
+				auto* bossHealth = bossObj->getComponent<HealthComponent>();
 				if (bossHealth) {
 					SDL_Color bossHealthColor = { 255, 0, 0, 255 }; // Red
 
-					std::stringstream bossSS;
-					bossSS << "Boss HP: " << bossHealth->getCurrentHealth()
-						<< "/" << bossHealth->getMaxHealth();
-					SDL_Texture* bossTex = renderText(renderer, hudFont, bossSS.str(), bossHealthColor);
-					if (bossTex) {
-						float w, h;
-						SDL_GetTextureSize(bossTex, &w, &h);
-						SDL_FRect bossDst = { 10, 120, w, h };
-						SDL_RenderTexture(renderer, bossTex, NULL, &bossDst);
-						SDL_DestroyTexture(bossTex);
-					}
+					char bossLabel[64];
+					std::snprintf(bossLabel, sizeof(bossLabel), "Boss HP: %d/%d",
+						bossHealth->getCurrentHealth(), bossHealth->getMaxHealth());
+					TextRenderer::draw(hudFont, bossLabel, bossHealthColor, 10, 120);
 				}
 			}
 		}
 	);
 
-	// Clean up
+#ifdef ENGINE_ENABLE_PROFILER
+	// Headless runs have no F9, keep the trace of the last frames
+	if (config.headless) Profiler::writeChromeTrace("boss_trace.json");
+#endif
+
+	SDL_Log("GameObject pool peak: %zu of %zu objects",
+		GameObjectAllocator::getPoolHighWaterMark(), GameObjectAllocator::getPoolCapacity());
+
+	// Clean up, the font's cached text goes while the renderer still exists
+	if (hudFont) {
+		TextRenderer::releaseFont(hudFont);
+		TTF_CloseFont(hudFont);
+	}
 	Engine::shutdown();
 
-	if (hudFont) TTF_CloseFont(hudFont);
 	TTF_Quit;
 
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 #include <engine/Component.h>
 #include <engine/TransformComponent.h>
 #include <engine/GameObject.h>
+#include <engine/Engine.h>
+#include <engine/System.h>
 #include <algorithm>
 
 class CameraComponent : public Component {
@@ -10,12 +12,13 @@ public:
 		: viewWidth(width), viewHeight(height), smoothFactor(smooth) {
 	}
 
-	void setTarget(GameObject* targetObj) { target = targetObj; }
+	void setTarget(EntityHandle targetObj) { target = targetObj; }
 
 	void update(GameObject& /*owner*/, float deltaTime) override {
-		if (!target) return;
+		GameObject* targetObj = Engine::resolve(target);
+		if (!targetObj) return;
 
-		auto* t = target->getComponent<TransformComponent>();
+		auto* t = targetObj->getComponent<TransformComponent>();
 		if (!t) return;
 
 		Vec2 targetPos = t->getPosition();
@@ -38,8 +41,25 @@ public:
 	Vec2 getOffset() const { return offset; }
 
 private:
-	GameObject* target = nullptr;
+	EntityHandle target;
 	Vec2 offset{ 0.f, 0.f };
 	float viewWidth, viewHeight;
 	float smoothFactor;
 };
+
+// Follows each camera's target. Reads the target's transform, so it runs after movement.
+class CameraSystem : public System {
+public:
+	CameraSystem() : System("Camera") {
+		reads<TransformComponent>();
+		writes<CameraComponent>();
+		replaces<CameraComponent>();
+	}
+
+	void update(float deltaTime) override {
+		for (auto [obj, camera] : Engine::view<CameraComponent>()) {
+			if (obj.isPaused()) continue;
+			camera.update(obj, deltaTime);
+		}
+	}
+};
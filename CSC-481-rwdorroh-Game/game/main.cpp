@@ -5,7 +5,7 @@
 #include <string>
 #include <unordered_map>
 #include <vector>
-#include <sstream>
+#include <cstdio>
 #include <thread>
 #include <mutex>
 
@@ -21,6 +21,8 @@
 #include <engine/GameObject.h>
 #include <engine/TransformComponent.h>
 #include <engine/RenderComponent.h>
+#include <engine/TextureAtlas.h>
+#include <engine/TextRenderer.h>
 #include <engine/ColliderComponent.h>
 #include <engine/GravityComponent.h>
 #include <engine/InputComponent.h>
@@ -32,14 +34,6 @@ TTF_Font* hudFont = nullptr;
 const std::vector<float> speedLevels = { 0.5f, 1.0f, 2.0f };
 size_t currentSpeedIndex = 1;
 
-SDL_Texture* renderText(SDL_Renderer* renderer, TTF_Font* font, const std::string& text, SDL_Color color) {
-    SDL_Surface* surface = TTF_RenderText_Solid(font, text.c_str(), text.length(), color);
-    if (!surface) return nullptr;
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_DestroySurface(surface);
-    return texture;
-}
-
 std::mutex stateMutex;
 struct ServerSnapshot {
     std::unordered_map<int, Vec2> otherPlayersPositions;
@@ -149,6 +143,7 @@ int main(int argc, char* argv[]) {
     config.title = "CSC 481 Game";
     config.width = 1900;
     config.height = 1000;
+    config.targetFps = 144.0f;
 
     if (TTF_Init() < 0) {
         SDL_Log("Failed to init TTF: %s", SDL_GetError());
@@ -166,6 +161,9 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    // Platforms, players and orbs all draw from one atlas page
+    TextureAtlas::build({ "assets/Brick.png", "assets/Morwen.png", "assets/Orb.png" });
+
     setupInputBindings();
 
     Timeline timeline;
@@ -177,39 +175,39 @@ int main(int argc, char* argv[]) {
 
     // Static platforms
     auto* platform = new GameObject();
-    platform->addComponent(std::make_unique<TransformComponent>(300, 800, 96, 32));
-    platform->addComponent(std::make_unique<RenderComponent>("assets/Brick.png"));
-    platform->addComponent(std::make_unique<ColliderComponent>());
+    platform->emplaceComponent<TransformComponent>(300, 800, 96, 32);
+    platform->emplaceComponent<RenderComponent>("assets/Brick.png");
+    platform->emplaceComponent<ColliderComponent>();
     Engine::addGameObject(platform);
 
     auto* abovePlatform = new GameObject();
-    abovePlatform->addComponent(std::make_unique<TransformComponent>(300, 400, 96, 32));
-    abovePlatform->addComponent(std::make_unique<RenderComponent>("assets/Brick.png"));
-    abovePlatform->addComponent(std::make_unique<ColliderComponent>());
+    abovePlatform->emplaceComponent<TransformComponent>(300, 400, 96, 32);
+    abovePlatform->emplaceComponent<RenderComponent>("assets/Brick.png");
+    abovePlatform->emplaceComponent<ColliderComponent>();
     Engine::addGameObject(abovePlatform);
 
     auto* midPlatform = new GameObject();
-    midPlatform->addComponent(std::make_unique<TransformComponent>(700, 600, 160, 32));
-    midPlatform->addComponent(std::make_unique<RenderComponent>("assets/Brick.png"));
-    midPlatform->addComponent(std::make_unique<ColliderComponent>());
+    midPlatform->emplaceComponent<TransformComponent>(700, 600, 160, 32);
+    midPlatform->emplaceComponent<RenderComponent>("assets/Brick.png");
+    midPlatform->emplaceComponent<ColliderComponent>();
     Engine::addGameObject(midPlatform);
 
     auto* movingPlatform = new GameObject();
-    movingPlatform->addComponent(std::make_unique<TransformComponent>(1100.f, 800.f, 200.f, 32.f, 150.f, 0.f));
-    movingPlatform->addComponent(std::make_unique<RenderComponent>("assets/Brick.png"));
-    movingPlatform->addComponent(std::make_unique<ColliderComponent>());
+    movingPlatform->emplaceComponent<TransformComponent>(1100.f, 800.f, 200.f, 32.f, 150.f, 0.f);
+    movingPlatform->emplaceComponent<RenderComponent>("assets/Brick.png");
+    movingPlatform->emplaceComponent<ColliderComponent>();
     Engine::addGameObject(movingPlatform);
 
     // Spawn points
     auto* defaultSpawn = new GameObject();
-    defaultSpawn->addComponent(std::make_unique<TransformComponent>(300, 500));
+    defaultSpawn->emplaceComponent<TransformComponent>(300, 500);
     Engine::addGameObject(defaultSpawn);
     auto* spawnTransform = defaultSpawn->getComponent<TransformComponent>();
     float spawnX = spawnTransform ? spawnTransform->getPosition().x : 300.f;
     float spawnY = spawnTransform ? spawnTransform->getPosition().y : 500.f;
 
     auto* mapDeathSpawn = new GameObject();
-    mapDeathSpawn->addComponent(std::make_unique<TransformComponent>(700, 400));
+    mapDeathSpawn->emplaceComponent<TransformComponent>(700, 400);
     Engine::addGameObject(mapDeathSpawn);
     auto* deathSpawnTransform = mapDeathSpawn->getComponent<TransformComponent>();
     float deathSpawnX = deathSpawnTransform ? deathSpawnTransform->getPosition().x : 700.f;
@@ -217,21 +215,22 @@ int main(int argc, char* argv[]) {
 
     // Local player
     auto* localPlayer = new GameObject();
-    localPlayer->addComponent(std::make_unique<TransformComponent>(spawnX, spawnY, 64, 64));
-    localPlayer->addComponent(std::make_unique<RenderComponent>("assets/Morwen.png"));
-    localPlayer->addComponent(std::make_unique<GravityComponent>(200.f));
-    localPlayer->addComponent(std::make_unique<InputComponent>());
-    localPlayer->addComponent(std::make_unique<ColliderComponent>());
+    localPlayer->emplaceComponent<TransformComponent>(spawnX, spawnY, 64, 64);
+    localPlayer->emplaceComponent<RenderComponent>("assets/Morwen.png");
+    localPlayer->emplaceComponent<GravityComponent>(200.f);
+    localPlayer->emplaceComponent<InputComponent>();
+    localPlayer->emplaceComponent<ColliderComponent>();
     Engine::addGameObject(localPlayer);
 
     // Camera
     auto* camera = new GameObject();
-    camera->addComponent(std::make_unique<CameraComponent>(config.width, config.height));
+    camera->emplaceComponent<CameraComponent>(config.width, config.height);
     Engine::addGameObject(camera);
+    Engine::addSystem<CameraSystem>();
     auto* camComp = camera->getComponent<CameraComponent>();
-    if (camComp) camComp->setTarget(localPlayer);
+    if (camComp) camComp->setTarget(localPlayer->getHandle());
 
-    std::unordered_map<int, GameObject*> otherPlayers;
+    std::unordered_map<int, EntityHandle> otherPlayers;
     GameObject* orb = nullptr;
     bool hasActivatedServerControl = false;
     GameObject* lastPlatform = nullptr;
@@ -279,7 +278,9 @@ int main(int argc, char* argv[]) {
 			// STEP 3: Dispatch events (updates playerState)
 			GlobalEventManager.dispatch(now);
 
-			std::vector<Event> raisedEvents;
+			// Lives until the command is sent at the end of this update, so the frame arena backs
+			// its storage. The Events in it still allocate their names and parameters.
+			std::pmr::vector<Event> raisedEvents(Engine::getFrameAllocator());
 
 			// Timeline controls (keep as is)
 			bool scaleUp = (actionMask & (1 << 2));
@@ -363,16 +364,13 @@ int main(int argc, char* argv[]) {
 			bool isOnGround = false;
 			GameObject* currentPlatform = nullptr;
 
-			for (GameObject* obj : Engine::getGameObjectsSnapshot()) {
-				if (obj == localPlayer) continue;
+			for (auto [obj, ot, oc] : Engine::view<TransformComponent, ColliderComponent>()) {
+				if (&obj == localPlayer) continue;
+				if (!oc.isCollidable()) continue;
 
-				auto* ot = obj->getComponent<TransformComponent>();
-				auto* oc = obj->getComponent<ColliderComponent>();
-				if (!ot || !oc || !oc->isCollidable()) continue;
-
-				if (Collision::checkCollision(*localPlayer, *obj)) {
+				if (Collision::checkCollision(*localPlayer, obj)) {
 					SDL_FRect playerRect = { pos.x, pos.y, transform->getSize().x, transform->getSize().y };
-					SDL_FRect otherRect = { ot->getPosition().x, ot->getPosition().y, ot->getSize().x, ot->getSize().y };
+					SDL_FRect otherRect = { ot.getPosition().x, ot.getPosition().y, ot.getSize().x, ot.getSize().y };
 
 					if (playerRect.y + playerRect.h <= otherRect.y + 10.f) {
 						pos.y = otherRect.y - playerRect.h;
@@ -380,7 +378,7 @@ int main(int argc, char* argv[]) {
 						transform->setPosition(pos.x, pos.y);
 						transform->setVelocity(vel.x, vel.y);
 						isOnGround = true;
-						currentPlatform = obj;
+						currentPlatform = &obj;
 					}
 				}
 			}
@@ -447,10 +445,10 @@ int main(int argc, char* argv[]) {
                         if (obj.id == 0 && obj.type == 0) {  // Moving platform
                             if (!movingPlatform) {
                                 movingPlatform = new GameObject();
-                                movingPlatform->addComponent(std::make_unique<TransformComponent>(obj.position.x, obj.position.y, 200, 32));
-                                movingPlatform->addComponent(std::make_unique<RenderComponent>("assets/Brick.png"));
-                                movingPlatform->addComponent(std::make_unique<ColliderComponent>());
-                                movingPlatform->addComponent(std::make_unique<NetworkComponent>(false, obj.id, obj.type));
+                                movingPlatform->emplaceComponent<TransformComponent>(obj.position.x, obj.position.y, 200, 32);
+                                movingPlatform->emplaceComponent<RenderComponent>("assets/Brick.png");
+                                movingPlatform->emplaceComponent<ColliderComponent>();
+                                movingPlatform->emplaceComponent<NetworkComponent>(false, obj.id, obj.type);
                                 Engine::addGameObject(movingPlatform);
                             }
                             auto* t = movingPlatform->getComponent<TransformComponent>();
@@ -460,10 +458,10 @@ int main(int argc, char* argv[]) {
                         if (obj.id == 1 && obj.type == 1) {  // Orb
                             if (!orb) {
                                 orb = new GameObject();
-                                orb->addComponent(std::make_unique<TransformComponent>(1920 - 128, 0, 128, 128, -400, 180));
-                                orb->addComponent(std::make_unique<RenderComponent>("assets/Orb.png"));
-                                orb->addComponent(std::make_unique<ColliderComponent>());
-                                orb->addComponent(std::make_unique<NetworkComponent>(false, obj.id, obj.type));
+                                orb->emplaceComponent<TransformComponent>(1920 - 128, 0, 128, 128, -400, 180);
+                                orb->emplaceComponent<RenderComponent>("assets/Orb.png");
+                                orb->emplaceComponent<ColliderComponent>();
+                                orb->emplaceComponent<NetworkComponent>(false, obj.id, obj.type);
                                 Engine::addGameObject(orb);
                             }
 
@@ -484,13 +482,12 @@ int main(int argc, char* argv[]) {
                     for (auto& [id, pos] : latestSnapshot.otherPlayersPositions) {
                         if (otherPlayers.find(id) == otherPlayers.end()) {
                             auto* np = new GameObject();
-                            np->addComponent(std::make_unique<TransformComponent>(pos.x, pos.y, 64, 64));
-                            np->addComponent(std::make_unique<RenderComponent>("assets/Morwen.png"));
-                            otherPlayers[id] = np;
-                            Engine::addGameObject(np);
+                            np->emplaceComponent<TransformComponent>(pos.x, pos.y, 64, 64);
+                            np->emplaceComponent<RenderComponent>("assets/Morwen.png");
+                            otherPlayers[id] = Engine::addGameObject(np);
                         }
-                        else {
-                            auto* t = otherPlayers[id]->getComponent<TransformComponent>();
+                        else if (GameObject* other = Engine::resolve(otherPlayers[id])) {
+                            auto* t = other->getComponent<TransformComponent>();
                             if (t) t->setPosition(pos.x, pos.y);
                         }
                     }
@@ -501,8 +498,7 @@ int main(int argc, char* argv[]) {
                         for (int id : latestSnapshot.removedIds) {
                             auto it = otherPlayers.find(id);
                             if (it != otherPlayers.end()) {
-                                GameObject* obj = it->second;
-                                Engine::queueRemove(obj);
+                                Engine::queueRemove(it->second);
                                 otherPlayers.erase(it);
                                 std::cout << "[Client] Removed player " << id << " (disconnected)\n";
                             }
@@ -519,8 +515,7 @@ int main(int argc, char* argv[]) {
             if (isConnected) {
                 auto* t = localPlayer->getComponent<TransformComponent>();
                 if (t) {
-                    ClientCommand cmd{ playerID, currentTick, actionMask, t->getPosition().x, t->getPosition().y };
-                    cmd.events = raisedEvents;
+                    ClientCommand cmd{ playerID, currentTick, actionMask, t->getPosition().x, t->getPosition().y, std::move(raisedEvents) };
                     net.sendCommand(cmd);
                 }
             }
@@ -532,25 +527,19 @@ int main(int argc, char* argv[]) {
             auto* camComp = camera->getComponent<CameraComponent>();
             if (camComp) cameraOffset = camComp->getOffset();
 
-            std::vector<GameObject*> objs = Engine::getGameObjectsSnapshot();
-            for (auto* obj : objs) {
-                if (!obj) continue;
-                auto* renderComp = obj->getComponent<RenderComponent>();
-                if (!renderComp) continue;
-                renderComp->draw(*obj, renderer, cameraOffset);
+            // Culled to the camera's view and batched by texture, flushed before the HUD so text stays on top
+            SpriteBatch& batch = Engine::getSpriteBatch();
+            SDL_FRect view = Engine::getViewRect(cameraOffset);
+            for (auto [obj, renderComp] : Engine::view<RenderComponent>()) {
+                renderComp.draw(obj, batch, view);
             }
+            batch.flush(renderer);
 
             SDL_Color black = { 0,0,0,255 };
-            std::stringstream ss;
-            ss << "Client ID: " << playerID << " | Speed: x" << timeline.getScale();
-            if (timeline.isPaused()) ss << " [PAUSED]";
-            SDL_Texture* tex = renderText(renderer, hudFont, ss.str(), black);
-            if (tex) {
-                float w, h; SDL_GetTextureSize(tex, &w, &h);
-                SDL_FRect dst = { 10, 10, w, h };
-                SDL_RenderTexture(renderer, tex, NULL, &dst);
-                SDL_DestroyTexture(tex);
-            }
+            char label[96];
+            std::snprintf(label, sizeof(label), "Client ID: %d | Speed: x%g%s",
+                playerID, timeline.getScale(), timeline.isPaused() ? " [PAUSED]" : "");
+            TextRenderer::draw(hudFont, label, black, 10, 10);
         }
     );
 
@@ -561,9 +550,13 @@ int main(int argc, char* argv[]) {
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
 
+    // Release the font's cached text while the renderer still exists
+    if (hudFont) {
+        TextRenderer::releaseFont(hudFont);
+        TTF_CloseFont(hudFont);
+    }
     Engine::shutdown();
 
-    if (hudFont) TTF_CloseFont(hudFont);
     TTF_Quit();
 
     return 0;
@@ -12,6 +12,7 @@
 #include <memory>
 #include <csignal>
 
+#include "../include/engine/Engine.h"
 #include "../include/engine/GameObject.h"
 #include "../include/engine/TransformComponent.h"
 #include "../include/engine/NetworkComponent.h"
@@ -21,6 +22,7 @@
 #include "../include/engine/Types.h"
 #include "../include/engine/Event.h"
 #include "../include/engine/EventManager.h"
+#include "../include/engine/FramePacer.h"
 
 // Struct with player information server needs
 struct PlayerInfo {
@@ -91,27 +93,27 @@ void initializeSyncedObjects() {
     std::lock_guard<std::mutex> lock(objectsMutex);
 
     auto platform = std::make_unique<GameObject>();
-    platform->addComponent(std::make_unique<TransformComponent>(1100.f, 700.f, 200.f, 32.f, 150.f, 0.f));
-    platform->addComponent(std::make_unique<NetworkComponent>(true, 0, 0));
+    platform->emplaceComponent<TransformComponent>(1100.f, 700.f, 200.f, 32.f, 150.f, 0.f);
+    platform->emplaceComponent<NetworkComponent>(true, 0, 0);
     syncedObjects[0] = std::move(platform);
 
     auto orb = std::make_unique<GameObject>();
-    orb->addComponent(std::make_unique<TransformComponent>(1920.f - 128.f, 0.f, 128.f, 128.f, -400.f, 180.f));
-    orb->addComponent(std::make_unique<NetworkComponent>(true, 1, 1));
+    orb->emplaceComponent<TransformComponent>(1920.f - 128.f, 0.f, 128.f, 128.f, -400.f, 180.f);
+    orb->emplaceComponent<NetworkComponent>(true, 1, 1);
     syncedObjects[1] = std::move(orb);
 
     auto platform2 = std::make_unique<GameObject>();
-    platform2->addComponent(std::make_unique<TransformComponent>(100.f, 300.f, 200.f, 32.f, 0.f, 150.f));
-    platform2->addComponent(std::make_unique<NetworkComponent>(true, 2, 2));
+    platform2->emplaceComponent<TransformComponent>(100.f, 300.f, 200.f, 32.f, 0.f, 150.f);
+    platform2->emplaceComponent<NetworkComponent>(true, 2, 2);
     syncedObjects[2] = std::move(platform2);
 }
 
 void updateSyncedObjects(float deltaTime) {
     std::lock_guard<std::mutex> lock(objectsMutex);
-    for (auto& [id, obj] : syncedObjects) {
-        auto* t = obj->getComponent<TransformComponent>();
-        auto* n = obj->getComponent<NetworkComponent>();
-        if (!t || !n || !n->serverControlled) continue;
+    for (auto [obj, transform, network] : Engine::view<TransformComponent, NetworkComponent>()) {
+        auto* t = &transform;
+        auto* n = &network;
+        if (!n->serverControlled) continue;
 
         if (n->typeId == 0) {
             Vec2 pos = t->getPosition();
@@ -205,6 +207,11 @@ void reply_handler(zmq::context_t& context, int clientID, int port) {
                             lineStream >> val;
                             e.addParam(key, Variant(val));
                         }
+                        else if (valType == "ENTITY") {
+                            uint64_t packed;
+                            lineStream >> packed;
+                            e.addParam(key, Variant(EntityHandle::unpack(packed)));
+                        }
                     }
 
                     serverEventManager.raise(e, static_cast<float>(tick));
@@ -277,10 +284,14 @@ void pub_handler(zmq::context_t& context) {
 
     static std::unordered_map<int, bool> previousPlayers;
 
+    // Absolute deadlines, so the work below doesn't stretch the tick
+    const double tickRate = 30.0;
+    FramePacer pacer(tickRate);
+
     while (running) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(33));
+        pacer.wait();
         ++tick;
-        updateSyncedObjects(0.033f);
+        updateSyncedObjects(static_cast<float>(1.0 / tickRate));
 
         // Dispatch events
         serverEventManager.dispatch(static_cast<float>(tick));
@@ -368,6 +379,11 @@ void pub_handler(zmq::context_t& context) {
         }
     }
 
+    if (pacer.getMissedDeadlines() > 0) {
+        std::cout << "[Server] Missed " << pacer.getMissedDeadlines() << " of "
+                  << pacer.getFrameCount() << " tick deadlines\n";
+    }
+
     publisher.close();
 }
 